@@ -6,6 +6,8 @@
  * The full license is in the file LICENSE, distributed with this software. *
  ****************************************************************************/
 
+#include <complex>
+
 #include <benchmark/benchmark.h>
 
 #include "xtensor/containers/xarray.hpp"
@@ -57,6 +59,46 @@ namespace xt
         }
     }
 
+    template <class T>
+    void benchmark_from_shape_initialized(benchmark::State& state)
+    {
+        using value_type = typename T::value_type;
+        std::size_t n = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state)
+        {
+            T e = T::from_shape({n, n});
+            e.fill(value_type(1));
+            benchmark::DoNotOptimize(e.data());
+        }
+    }
+
+    template <class T>
+    void benchmark_from_shape_uninitialized(benchmark::State& state)
+    {
+        using value_type = typename T::value_type;
+        std::size_t n = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state)
+        {
+            T e = T::from_shape({n, n}, uninitialized);
+            e.fill(value_type(1));
+            benchmark::DoNotOptimize(e.data());
+        }
+    }
+
+    template <class T>
+    void benchmark_assign_new(benchmark::State& state)
+    {
+        using value_type = typename T::value_type;
+        std::size_t n = static_cast<std::size_t>(state.range(0));
+        T a = T::from_shape({n, n});
+        a.fill(value_type(2));
+        for (auto _ : state)
+        {
+            T e = a * a;
+            benchmark::DoNotOptimize(e.data());
+        }
+    }
+
     BENCHMARK(benchmark_empty);
     BENCHMARK(benchmark_empty_to_xtensor);
     BENCHMARK(benchmark_empty_to_xarray);
@@ -64,4 +106,9 @@ namespace xt
     BENCHMARK_TEMPLATE(benchmark_from_shape, xtensor<double, 2>);
     BENCHMARK_TEMPLATE(benchmark_creation, xarray<double>);
     BENCHMARK_TEMPLATE(benchmark_creation, xtensor<double, 2>);
+    BENCHMARK_TEMPLATE(benchmark_from_shape_initialized, xtensor<std::complex<double>, 2>)->Range(32, 2048);
+    BENCHMARK_TEMPLATE(benchmark_from_shape_uninitialized, xtensor<std::complex<double>, 2>)->Range(32, 2048);
+    BENCHMARK_TEMPLATE(benchmark_from_shape_initialized, xarray<std::complex<double>>)->Range(32, 2048);
+    BENCHMARK_TEMPLATE(benchmark_from_shape_uninitialized, xarray<std::complex<double>>)->Range(32, 2048);
+    BENCHMARK_TEMPLATE(benchmark_assign_new, xtensor<std::complex<double>, 2>)->Range(32, 2048);
 }
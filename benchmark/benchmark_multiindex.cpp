@@ -0,0 +1,136 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay and Wolf Vollprecht          *
+ * Copyright (c) QuantStack                                                 *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include <array>
+#include <cstddef>
+
+#include <benchmark/benchmark.h>
+
+#include "xtensor/containers/xtensor.hpp"
+#include "xtensor/core/xmultiindex_iterator.hpp"
+#include "xtensor/generators/xbuilder.hpp"
+
+namespace xt
+{
+    namespace benchmark_multiindex
+    {
+        // Visit of all the indices of a 4-D tensor, each visit writing one
+        // element: b[index] = 2 * a[index].
+        using tensor_type = xtensor<double, 4>;
+        using index_type = std::array<std::size_t, 4>;
+
+        inline tensor_type make_tensor(std::size_t n)
+        {
+            tensor_type a = tensor_type::from_shape({n, n, n, n});
+            a = arange<double>(static_cast<double>(a.size())).reshape(a.shape());
+            return a;
+        }
+
+        void multiindex_iterator_dynamic(benchmark::State& state)
+        {
+            const auto n = static_cast<std::size_t>(state.range(0));
+            tensor_type a = make_tensor(n);
+            tensor_type b = tensor_type::from_shape(a.shape());
+            xindex first = {0, 0, 0, 0};
+            xindex last = {n, n, n, n};
+            for (auto _ : state)
+            {
+                auto end = multiindex_iterator_end<xindex>(first, last);
+                for (auto it = multiindex_iterator_begin<xindex>(first, last); it != end; ++it)
+                {
+                    b.element((*it).cbegin(), (*it).cend()) = 2. * a.element((*it).cbegin(), (*it).cend());
+                }
+                benchmark::DoNotOptimize(b.data());
+            }
+        }
+
+        void multiindex_iterator_fixed(benchmark::State& state)
+        {
+            const auto n = static_cast<std::size_t>(state.range(0));
+            tensor_type a = make_tensor(n);
+            tensor_type b = tensor_type::from_shape(a.shape());
+            auto r = multiindex_range(a.shape());
+            for (auto _ : state)
+            {
+                for (auto it = r.begin(); it != r.end(); ++it)
+                {
+                    b[*it] = 2. * a[*it];
+                }
+                benchmark::DoNotOptimize(b.data());
+            }
+        }
+
+        void multiindex_range_for_each(benchmark::State& state)
+        {
+            const auto n = static_cast<std::size_t>(state.range(0));
+            tensor_type a = make_tensor(n);
+            tensor_type b = tensor_type::from_shape(a.shape());
+            auto r = multiindex_range(a.shape());
+            for (auto _ : state)
+            {
+                r.for_each(
+                    [&](const index_type& index)
+                    {
+                        b[index] = 2. * a[index];
+                    }
+                );
+                benchmark::DoNotOptimize(b.data());
+            }
+        }
+
+        void multiindex_range_parallel_for_each(benchmark::State& state)
+        {
+            const auto n = static_cast<std::size_t>(state.range(0));
+            tensor_type a = make_tensor(n);
+            tensor_type b = tensor_type::from_shape(a.shape());
+            auto r = multiindex_range(a.shape());
+            for (auto _ : state)
+            {
+                r.parallel_for_each(
+                    [&](const index_type& index)
+                    {
+                        b[index] = 2. * a[index];
+                    }
+                );
+                benchmark::DoNotOptimize(b.data());
+            }
+        }
+
+        // Lower bound: hand written nested loops
+        void multiindex_nested_loops(benchmark::State& state)
+        {
+            const auto n = static_cast<std::size_t>(state.range(0));
+            tensor_type a = make_tensor(n);
+            tensor_type b = tensor_type::from_shape(a.shape());
+            for (auto _ : state)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    for (std::size_t j = 0; j < n; ++j)
+                    {
+                        for (std::size_t k = 0; k < n; ++k)
+                        {
+                            for (std::size_t l = 0; l < n; ++l)
+                            {
+                                b(i, j, k, l) = 2. * a(i, j, k, l);
+                            }
+                        }
+                    }
+                }
+                benchmark::DoNotOptimize(b.data());
+            }
+        }
+
+        BENCHMARK(multiindex_iterator_dynamic)->Arg(8)->Arg(32);
+        BENCHMARK(multiindex_iterator_fixed)->Arg(8)->Arg(32);
+        BENCHMARK(multiindex_range_for_each)->Arg(8)->Arg(32);
+        BENCHMARK(multiindex_range_parallel_for_each)->Arg(8)->Arg(32);
+        BENCHMARK(multiindex_nested_loops)->Arg(8)->Arg(32);
+    }
+}
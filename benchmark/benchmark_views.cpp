@@ -293,4 +293,75 @@ namespace xt
         BENCHMARK_CAPTURE(transpose_assign_rm_cm, 10x20x500, {10, 20, 500});
         BENCHMARK_CAPTURE(transpose_assign_cm_rm, 10x20x500, {10, 20, 500});
     }
+
+    namespace block_assign
+    {
+        // Assignment through the block replication of xrepeat and xbroadcast
+        // against the generic stepper loop.
+        template <class E>
+        inline void assign_blocks(benchmark::State& state, const E& e)
+        {
+            xarray<double> res;
+            for (auto _ : state)
+            {
+                xt::noalias(res) = e;
+                benchmark::DoNotOptimize(res.data());
+            }
+        }
+
+        template <class E>
+        inline void assign_stepper(benchmark::State& state, const E& e)
+        {
+            xarray<double> res = xarray<double>::from_shape(e.shape());
+            for (auto _ : state)
+            {
+                xt::assign_data(res, e, false);
+                benchmark::DoNotOptimize(res.data());
+            }
+        }
+
+        inline void repeat_blocks(benchmark::State& state)
+        {
+            xarray<double> a = xt::arange<double>(500 * 500);
+            a.reshape({500, 500});
+            assign_blocks(state, xt::repeat(a, 4, std::size_t(state.range(0))));
+        }
+
+        inline void repeat_stepper(benchmark::State& state)
+        {
+            xarray<double> a = xt::arange<double>(500 * 500);
+            a.reshape({500, 500});
+            assign_stepper(state, xt::repeat(a, 4, std::size_t(state.range(0))));
+        }
+
+        // A row of 1000 elements, or a column when column is true
+        inline xarray<double> broadcast_operand(bool column)
+        {
+            xarray<double> a = xt::arange<double>(1000);
+            if (column)
+            {
+                a.reshape({1000, 1});
+            }
+            return a;
+        }
+
+        inline void broadcast_blocks(benchmark::State& state)
+        {
+            xarray<double> a = broadcast_operand(state.range(0) != 0);
+            assign_blocks(state, xt::broadcast(a, {1000, 1000}));
+        }
+
+        inline void broadcast_stepper(benchmark::State& state)
+        {
+            xarray<double> a = broadcast_operand(state.range(0) != 0);
+            assign_stepper(state, xt::broadcast(a, {1000, 1000}));
+        }
+
+        // range(0) is the repeated axis
+        BENCHMARK(repeat_blocks)->Arg(0)->Arg(1);
+        BENCHMARK(repeat_stepper)->Arg(0)->Arg(1);
+        // range(0): 0 broadcasts a row, 1 broadcasts a column
+        BENCHMARK(broadcast_blocks)->Arg(0)->Arg(1);
+        BENCHMARK(broadcast_stepper)->Arg(0)->Arg(1);
+    }
 }
@@ -107,6 +107,7 @@ namespace xt
 
         xarray_container();
         explicit xarray_container(const shape_type& shape, layout_type l = L);
+        explicit xarray_container(const shape_type& shape, uninitialized_t, layout_type l = L);
         explicit xarray_container(const shape_type& shape, const_reference value, layout_type l = L);
         explicit xarray_container(const shape_type& shape, const strides_type& strides);
         explicit xarray_container(const shape_type& shape, const strides_type& strides, const_reference value);
@@ -121,6 +122,8 @@ namespace xt
 
         template <class S = shape_type>
         static xarray_container from_shape(S&& s);
+        template <class S = shape_type>
+        static xarray_container from_shape(S&& s, uninitialized_t);
 
         ~xarray_container() = default;
 
@@ -296,6 +299,26 @@ namespace xt
         base_type::resize(shape, l);
     }
 
+    /**
+     * Allocates an xarray_container with the specified shape and layout_type
+     * without initializing its elements, not even those of a type with a
+     * non-trivial default constructor such as std::complex. Use it when
+     * every element is written right after the construction.
+     * @param shape the shape of the xarray_container
+     * @param l the layout_type of the xarray_container
+     * @sa is_uninitialized_safe
+     */
+    template <class EC, layout_type L, class SC, class Tag>
+    inline xarray_container<EC, L, SC, Tag>::xarray_container(
+        const shape_type& shape,
+        uninitialized_t,
+        layout_type l
+    )
+        : base_type()
+    {
+        base_type::resize(shape, l, uninitialized);
+    }
+
     /**
      * Allocates an xarray_container with the specified shape and layout_type. Elements
      * are initialized to the specified value.
@@ -311,7 +334,7 @@ namespace xt
     )
         : base_type()
     {
-        base_type::resize(shape, l);
+        base_type::resize(shape, l, uninitialized);
         std::fill(m_storage.begin(), m_storage.end(), value);
     }
 
@@ -462,6 +485,20 @@ namespace xt
         return self_type(shape);
     }
 
+    /**
+     * Allocates and returns an xarray_container with the specified shape,
+     * without initializing its elements.
+     * @param s the shape of the xarray_container
+     */
+    template <class EC, layout_type L, class SC, class Tag>
+    template <class S>
+    inline xarray_container<EC, L, SC, Tag>
+    xarray_container<EC, L, SC, Tag>::from_shape(S&& s, uninitialized_t)
+    {
+        shape_type shape = xtl::forward_sequence<shape_type, S>(s);
+        return self_type(shape, uninitialized);
+    }
+
     template <class EC, layout_type L, class SC, class Tag>
     template <std::size_t N>
     inline xarray_container<EC, L, SC, Tag>::xarray_container(xtensor_container<EC, N, L, Tag>&& rhs)
@@ -276,8 +276,12 @@ namespace xt
         template <class S = shape_type>
         void resize(S&& shape, bool force = false);
         template <class S = shape_type>
+        void resize(S&& shape, uninitialized_t);
+        template <class S = shape_type>
         void resize(S&& shape, layout_type l);
         template <class S = shape_type>
+        void resize(S&& shape, layout_type l, uninitialized_t);
+        template <class S = shape_type>
         void resize(S&& shape, const strides_type& strides);
 
         template <class S = shape_type>
@@ -321,6 +325,11 @@ namespace xt
 
     private:
 
+        template <class S, class... Init>
+        void resize_impl(S&& shape, bool force, Init... init);
+        template <class S, class... Init>
+        void resize_impl(S&& shape, layout_type l, Init... init);
+
         inner_shape_type m_shape;
         inner_strides_type m_strides;
         inner_backstrides_type m_backstrides;
@@ -965,6 +974,18 @@ namespace xt
             xt::resize_container(c, size);
         }
 
+        template <class C, class S>
+        inline void resize_data_container(C& c, S size, uninitialized_t)
+        {
+            xt::resize_container(c, size, uninitialized);
+        }
+
+        template <class C, class S>
+        inline void resize_data_container(const C& c, S size, uninitialized_t)
+        {
+            resize_data_container(c, size);
+        }
+
         template <class C, class S>
         inline void resize_data_container(const C& c, S size)
         {
@@ -996,6 +1017,28 @@ namespace xt
     template <class D>
     template <class S>
     inline void xstrided_container<D>::resize(S&& shape, bool force)
+    {
+        resize_impl(std::forward<S>(shape), force);
+    }
+
+    /**
+     * Resizes the container without initializing the new elements.
+     * The content of the container is indeterminate until it is assigned;
+     * this avoids writing the elements twice when they are all computed
+     * right after the resize. Element types that cannot be left
+     * unconstructed (see is_uninitialized_safe) are value-initialized.
+     * @param shape the new shape
+     */
+    template <class D>
+    template <class S>
+    inline void xstrided_container<D>::resize(S&& shape, uninitialized_t)
+    {
+        resize_impl(std::forward<S>(shape), false, uninitialized);
+    }
+
+    template <class D>
+    template <class S, class... Init>
+    inline void xstrided_container<D>::resize_impl(S&& shape, bool force, Init... init)
     {
         XTENSOR_PRECONDITION(
             detail::check_resize_dimension(m_shape, shape),
@@ -1014,7 +1057,7 @@ namespace xt
             resize_container(m_strides, dim);
             resize_container(m_backstrides, dim);
             size_type data_size = compute_strides<D::static_layout>(m_shape, m_layout, m_strides, m_backstrides);
-            detail::resize_data_container(this->storage(), data_size);
+            detail::resize_data_container(this->storage(), data_size, init...);
         }
     }
 
@@ -1028,6 +1071,26 @@ namespace xt
     template <class D>
     template <class S>
     inline void xstrided_container<D>::resize(S&& shape, layout_type l)
+    {
+        resize_impl(std::forward<S>(shape), l);
+    }
+
+    /**
+     * Resizes the container without initializing the new elements.
+     * @param shape the new shape
+     * @param l the new layout_type
+     * @sa resize(S&&, uninitialized_t)
+     */
+    template <class D>
+    template <class S>
+    inline void xstrided_container<D>::resize(S&& shape, layout_type l, uninitialized_t)
+    {
+        resize_impl(std::forward<S>(shape), l, uninitialized);
+    }
+
+    template <class D>
+    template <class S, class... Init>
+    inline void xstrided_container<D>::resize_impl(S&& shape, layout_type l, Init... init)
     {
         XTENSOR_ASSERT_MSG(
             detail::check_resize_dimension(m_shape, shape),
@@ -1041,7 +1104,7 @@ namespace xt
             );
         }
         m_layout = l;
-        resize(std::forward<S>(shape), true);
+        resize_impl(std::forward<S>(shape), true, init...);
     }
 
     /**
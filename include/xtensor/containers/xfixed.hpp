@@ -317,6 +317,7 @@ namespace xt
         xfixed_container() = default;
         xfixed_container(const value_type& v);
         explicit xfixed_container(const inner_shape_type& shape, layout_type l = L);
+        explicit xfixed_container(const inner_shape_type& shape, uninitialized_t, layout_type l = L);
         explicit xfixed_container(const inner_shape_type& shape, value_type v, layout_type l = L);
 
         template <class IX = std::integral_constant<std::size_t, N>>
@@ -339,9 +340,13 @@ namespace xt
 
         template <class ST = std::array<std::size_t, N>>
         static xfixed_container from_shape(ST&& /*s*/);
+        template <class ST = std::array<std::size_t, N>>
+        static xfixed_container from_shape(ST&& /*s*/, uninitialized_t);
 
         template <class ST = std::array<std::size_t, N>>
         void resize(ST&& shape, bool force = false) const;
+        template <class ST = std::array<std::size_t, N>>
+        void resize(ST&& shape, uninitialized_t) const;
         template <class ST = shape_type>
         void resize(ST&& shape, layout_type l) const;
         template <class ST = shape_type>
@@ -464,6 +469,8 @@ namespace xt
 
         template <class ST = std::array<std::size_t, N>>
         void resize(ST&& shape, bool force = false) const;
+        template <class ST = std::array<std::size_t, N>>
+        void resize(ST&& shape, uninitialized_t) const;
         template <class ST = shape_type>
         void resize(ST&& shape, layout_type l) const;
         template <class ST = shape_type>
@@ -523,6 +530,25 @@ namespace xt
         XTENSOR_ASSERT(L == l);
     }
 
+    /**
+     * Create an xfixed_container without initializing its elements.
+     * The storage of an xfixed_container is default-initialized, so this
+     * is equivalent to the constructor without the tag; it is provided for
+     * homogeneity with xarray and xtensor.
+     *
+     * @param shape the shape of the xfixed_container (unused!)
+     * @param l the layout_type of the xfixed_container (unused!)
+     */
+    template <class ET, class S, layout_type L, bool SH, class Tag>
+    inline xfixed_container<ET, S, L, SH, Tag>::xfixed_container(
+        const inner_shape_type& shape,
+        uninitialized_t,
+        layout_type l
+    )
+        : xfixed_container(shape, l)
+    {
+    }
+
     template <class ET, class S, layout_type L, bool SH, class Tag>
     inline xfixed_container<ET, S, L, SH, Tag>::xfixed_container(const value_type& v)
     {
@@ -595,6 +621,14 @@ namespace xt
         return tmp;
     }
 
+    template <class ET, class S, layout_type L, bool SH, class Tag>
+    template <class ST>
+    inline xfixed_container<ET, S, L, SH, Tag>
+    xfixed_container<ET, S, L, SH, Tag>::from_shape(ST&& shape, uninitialized_t)
+    {
+        return from_shape(std::forward<ST>(shape));
+    }
+
     /**
      * Allocates an xfixed_container with shape S with values from a C array.
      * The type returned by get_init_type_t is raw C array ``value_type[X][Y][Z]`` for
@@ -655,6 +689,13 @@ namespace xt
         XTENSOR_ASSERT(std::equal(shape.begin(), shape.end(), m_shape.begin()) && shape.size() == m_shape.size());
     }
 
+    template <class ET, class S, layout_type L, bool SH, class Tag>
+    template <class ST>
+    inline void xfixed_container<ET, S, L, SH, Tag>::resize(ST&& shape, uninitialized_t) const
+    {
+        resize(std::forward<ST>(shape));
+    }
+
     /**
      * Note that the xfixed_container **cannot** be resized. Attempting to resize with a different
      * size throws an assert in debug mode.
@@ -851,6 +892,13 @@ namespace xt
         XTENSOR_ASSERT(std::equal(shape.begin(), shape.end(), m_shape.begin()) && shape.size() == m_shape.size());
     }
 
+    template <class ET, class S, layout_type L, bool SH, class Tag>
+    template <class ST>
+    inline void xfixed_adaptor<ET, S, L, SH, Tag>::resize(ST&& shape, uninitialized_t) const
+    {
+        resize(std::forward<ST>(shape));
+    }
+
     /**
      * Note that the xfixed_adaptor **cannot** be resized. Attempting to resize with a different
      * size throws an assert in debug mode.
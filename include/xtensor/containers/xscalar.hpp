@@ -383,6 +383,9 @@ namespace xt
         template <class T>
         simd_return_type<T> step_simd();
 
+        template <class T>
+        simd_return_type<T> step_simd(size_type dim);
+
         void step_leading();
 
     private:
@@ -1019,6 +1022,13 @@ namespace xt
         return simd_return_type<T>(p_c->operator()());
     }
 
+    template <bool is_const, class CT>
+    template <class T>
+    inline auto xscalar_stepper<is_const, CT>::step_simd(size_type /*dim*/) -> simd_return_type<T>
+    {
+        return step_simd<T>();
+    }
+
     template <bool is_const, class CT>
     inline void xscalar_stepper<is_const, CT>::step_leading()
     {
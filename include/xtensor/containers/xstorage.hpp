@@ -12,14 +12,17 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <type_traits>
 
 #include "../core/xtensor_config.hpp"
 #include "../utils/xexception.hpp"
+#include "../utils/xinstrumentation.hpp"
 #include "../utils/xtensor_simd.hpp"
 #include "../utils/xutils.hpp"
 
@@ -55,6 +58,7 @@ namespace xt
         explicit uvector(const allocator_type& alloc) noexcept;
         explicit uvector(size_type count, const allocator_type& alloc = allocator_type());
         uvector(size_type count, const_reference value, const allocator_type& alloc = allocator_type());
+        uvector(size_type count, uninitialized_t, const allocator_type& alloc = allocator_type());
 
         template <std::input_iterator InputIt>
         uvector(InputIt first, InputIt last, const allocator_type& alloc = allocator_type());
@@ -76,6 +80,7 @@ namespace xt
         bool empty() const noexcept;
         size_type size() const noexcept;
         void resize(size_type size);
+        void resize(size_type size, uninitialized_t);
         size_type max_size() const noexcept;
         void reserve(size_type new_cap);
         size_type capacity() const noexcept;
@@ -122,7 +127,8 @@ namespace xt
         template <class I>
         void init_data(I first, I last);
 
-        void resize_impl(size_type new_size);
+        template <class... Init>
+        void resize_impl(size_type new_size, Init... init);
 
         allocator_type m_allocator;
 
@@ -159,6 +165,22 @@ namespace xt
 
     namespace detail
     {
+        template <class A>
+        inline typename std::allocator_traits<A>::pointer
+        allocate_storage(A& alloc, typename std::allocator_traits<A>::size_type size)
+        {
+            XTENSOR_INSTRUMENT(
+                const auto count = static_cast<std::size_t>(size);
+                instrumentation::scoped_event event(
+                    instrumentation::event_kind::allocation,
+                    "storage",
+                    count,
+                    count * sizeof(typename std::allocator_traits<A>::value_type)
+                );
+            )
+            return alloc.allocate(size);
+        }
+
         template <class A>
         inline typename std::allocator_traits<A>::pointer
         safe_init_allocate(A& alloc, typename std::allocator_traits<A>::size_type size)
@@ -166,7 +188,7 @@ namespace xt
             using traits = std::allocator_traits<A>;
             using pointer = typename traits::pointer;
             using value_type = typename traits::value_type;
-            pointer res = alloc.allocate(size);
+            pointer res = allocate_storage(alloc, size);
             if (!std::is_trivially_default_constructible<value_type>::value)
             {
                 for (pointer p = res; p != res + size; ++p)
@@ -177,6 +199,21 @@ namespace xt
             return res;
         }
 
+        template <class A>
+        inline typename std::allocator_traits<A>::pointer
+        safe_init_allocate(A& alloc, typename std::allocator_traits<A>::size_type size, uninitialized_t)
+        {
+            using value_type = typename std::allocator_traits<A>::value_type;
+            if constexpr (is_uninitialized_safe<value_type>::value)
+            {
+                return allocate_storage(alloc, size);
+            }
+            else
+            {
+                return safe_init_allocate(alloc, size);
+            }
+        }
+
         template <class A>
         inline void safe_destroy_deallocate(
             A& alloc,
@@ -196,6 +233,12 @@ namespace xt
                         traits::destroy(alloc, p);
                     }
                 }
+                XTENSOR_INSTRUMENT(
+                    const auto count = static_cast<std::size_t>(size);
+                    instrumentation::notify(
+                        {instrumentation::event_kind::deallocation, "storage", instrumentation::assigner_path::none, count, count * sizeof(value_type)}
+                    );
+                )
                 traits::deallocate(alloc, ptr, size);
             }
         }
@@ -208,20 +251,21 @@ namespace xt
         size_type size = static_cast<size_type>(std::distance(first, last));
         if (size != size_type(0))
         {
-            p_begin = m_allocator.allocate(size);
+            p_begin = detail::allocate_storage(m_allocator, size);
             std::uninitialized_copy(first, last, p_begin);
             p_end = p_begin + size;
         }
     }
 
     template <class T, class A>
-    inline void uvector<T, A>::resize_impl(size_type new_size)
+    template <class... Init>
+    inline void uvector<T, A>::resize_impl(size_type new_size, Init... init)
     {
         size_type old_size = size();
         pointer old_begin = p_begin;
         if (new_size != old_size)
         {
-            p_begin = detail::safe_init_allocate(m_allocator, new_size);
+            p_begin = detail::safe_init_allocate(m_allocator, new_size, init...);
             p_end = p_begin + new_size;
             detail::safe_destroy_deallocate(m_allocator, old_begin, old_size);
         }
@@ -262,12 +306,29 @@ namespace xt
     {
         if (count != 0)
         {
-            p_begin = m_allocator.allocate(count);
+            p_begin = detail::allocate_storage(m_allocator, count);
             p_end = p_begin + count;
             std::uninitialized_fill(p_begin, p_end, value);
         }
     }
 
+    /**
+     * Allocates \c count elements without initializing them when
+     * is_uninitialized_safe<T> holds, value-initializes them otherwise.
+     */
+    template <class T, class A>
+    inline uvector<T, A>::uvector(size_type count, uninitialized_t, const allocator_type& alloc)
+        : m_allocator(alloc)
+        , p_begin(nullptr)
+        , p_end(nullptr)
+    {
+        if (count != 0)
+        {
+            p_begin = detail::safe_init_allocate(m_allocator, count, uninitialized);
+            p_end = p_begin + count;
+        }
+    }
+
     template <class T, class A>
     template <std::input_iterator InputIt>
     inline uvector<T, A>::uvector(InputIt first, InputIt last, const allocator_type& alloc)
@@ -324,7 +385,7 @@ namespace xt
             m_allocator = std::allocator_traits<allocator_type>::select_on_container_copy_construction(
                 rhs.get_allocator()
             );
-            resize_impl(rhs.size());
+            resize_impl(rhs.size(), uninitialized);
             if (std::is_trivially_default_constructible<value_type>::value)
             {
                 std::uninitialized_copy(rhs.p_begin, rhs.p_end, p_begin);
@@ -391,6 +452,17 @@ namespace xt
         resize_impl(size);
     }
 
+    /**
+     * Resizes the container; the new elements are left uninitialized when
+     * is_uninitialized_safe<T> holds. Like resize(size), the content is
+     * not preserved when the size changes.
+     */
+    template <class T, class A>
+    inline void uvector<T, A>::resize(size_type size, uninitialized_t)
+    {
+        resize_impl(size, uninitialized);
+    }
+
     template <class T, class A>
     inline auto uvector<T, A>::max_size() const noexcept -> size_type
     {
@@ -1411,6 +1483,697 @@ namespace xt
         using type = svector<X, N, allocator, B>;
     };
 
+    /*********************************
+     * compact_vector implementation *
+     *********************************/
+
+    /**
+     * @class compact_vector
+     * @brief Small vector of trivially copyable values for shapes and strides.
+     *
+     * Up to \c N elements are stored inline; larger sizes spill to the heap.
+     * Contrary to svector, the inline buffer and the heap pointer share the
+     * same memory and the size and capacity are stored as 32-bit integers,
+     * so that ``sizeof(compact_vector<std::size_t, N>)`` is ``8 * N + 8``
+     * bytes on 64-bit platforms. Copying and moving never need to fix up
+     * self-referencing pointers.
+     *
+     * @tparam T the type of the elements, must be trivially copyable.
+     * @tparam N the number of elements stored inline.
+     * @tparam A a stateless allocator used when the size exceeds \c N.
+     */
+    template <class T, std::size_t N = 8, class A = std::allocator<T>>
+    class compact_vector
+    {
+    public:
+
+        static_assert(std::is_trivially_copyable<T>::value, "compact_vector requires trivially copyable elements");
+        static_assert(N > 0, "compact_vector requires a non-empty inline buffer");
+        static_assert(
+            std::allocator_traits<A>::is_always_equal::value,
+            "compact_vector requires a stateless allocator"
+        );
+
+        using self_type = compact_vector<T, N, A>;
+        using allocator_type = A;
+        using size_type = std::size_t;
+        using value_type = T;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using difference_type = std::ptrdiff_t;
+
+        using iterator = pointer;
+        using const_iterator = const_pointer;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        compact_vector() noexcept;
+        ~compact_vector();
+
+        explicit compact_vector(const allocator_type& alloc) noexcept;
+        explicit compact_vector(size_type n, const allocator_type& alloc = allocator_type());
+        compact_vector(size_type n, const value_type& v, const allocator_type& alloc = allocator_type());
+        compact_vector(std::initializer_list<T> il, const allocator_type& alloc = allocator_type());
+
+        compact_vector(const std::vector<T>& vec);
+
+        template <std::input_iterator IT>
+        compact_vector(IT begin, IT end, const allocator_type& alloc = allocator_type());
+
+        compact_vector(const compact_vector& rhs);
+        compact_vector(compact_vector&& rhs) noexcept;
+
+        compact_vector& operator=(const compact_vector& rhs);
+        compact_vector& operator=(compact_vector&& rhs) noexcept;
+        compact_vector& operator=(const std::vector<T>& rhs);
+        compact_vector& operator=(std::initializer_list<T> il);
+
+        void assign(size_type n, const value_type& v);
+
+        template <class IT>
+        void assign(IT other_begin, IT other_end);
+
+        reference operator[](size_type idx);
+        const_reference operator[](size_type idx) const;
+
+        reference at(size_type idx);
+        const_reference at(size_type idx) const;
+
+        pointer data() noexcept;
+        const_pointer data() const noexcept;
+
+        void push_back(const T& elt);
+        void pop_back();
+
+        iterator begin() noexcept;
+        const_iterator begin() const noexcept;
+        const_iterator cbegin() const noexcept;
+        iterator end() noexcept;
+        const_iterator end() const noexcept;
+        const_iterator cend() const noexcept;
+
+        reverse_iterator rbegin() noexcept;
+        const_reverse_iterator rbegin() const noexcept;
+        const_reverse_iterator crbegin() const noexcept;
+        reverse_iterator rend() noexcept;
+        const_reverse_iterator rend() const noexcept;
+        const_reverse_iterator crend() const noexcept;
+
+        bool empty() const noexcept;
+        size_type size() const noexcept;
+        void resize(size_type n);
+        void resize(size_type n, const value_type& v);
+        size_type max_size() const noexcept;
+        size_type capacity() const noexcept;
+        void reserve(size_type n);
+        void shrink_to_fit();
+        void clear() noexcept;
+
+        reference front();
+        const_reference front() const;
+        reference back();
+        const_reference back() const;
+
+        bool on_stack() const noexcept;
+
+        iterator erase(const_iterator cit);
+        iterator erase(const_iterator cfirst, const_iterator clast);
+
+        iterator insert(const_iterator it, const T& elt);
+
+        template <class It>
+        iterator insert(const_iterator pos, It first, It last);
+
+        iterator insert(const_iterator pos, std::initializer_list<T> l);
+
+        void swap(compact_vector& rhs) noexcept;
+
+        allocator_type get_allocator() const noexcept;
+
+    private:
+
+        void grow(size_type min_capacity);
+        void release() noexcept;
+
+        static void copy_elements(const T* first, size_type n, T* out) noexcept;
+
+        std::uint32_t m_size = 0;
+        std::uint32_t m_capacity = static_cast<std::uint32_t>(N);
+
+        union
+        {
+            T m_data[N];
+            T* m_heap;
+        };
+    };
+
+    template <class T, std::size_t N, class A>
+    inline compact_vector<T, N, A>::compact_vector() noexcept
+    {
+    }
+
+    template <class T, std::size_t N, class A>
+    inline compact_vector<T, N, A>::~compact_vector()
+    {
+        release();
+    }
+
+    template <class T, std::size_t N, class A>
+    inline compact_vector<T, N, A>::compact_vector(const allocator_type&) noexcept
+    {
+    }
+
+    template <class T, std::size_t N, class A>
+    inline compact_vector<T, N, A>::compact_vector(size_type n, const allocator_type&)
+    {
+        resize(n);
+    }
+
+    template <class T, std::size_t N, class A>
+    inline compact_vector<T, N, A>::compact_vector(size_type n, const value_type& v, const allocator_type&)
+    {
+        assign(n, v);
+    }
+
+    template <class T, std::size_t N, class A>
+    inline compact_vector<T, N, A>::compact_vector(std::initializer_list<T> il, const allocator_type&)
+    {
+        assign(il.begin(), il.end());
+    }
+
+    template <class T, std::size_t N, class A>
+    inline compact_vector<T, N, A>::compact_vector(const std::vector<T>& vec)
+    {
+        assign(vec.begin(), vec.end());
+    }
+
+    template <class T, std::size_t N, class A>
+    template <std::input_iterator IT>
+    inline compact_vector<T, N, A>::compact_vector(IT begin, IT end, const allocator_type&)
+    {
+        assign(begin, end);
+    }
+
+    template <class T, std::size_t N, class A>
+    inline compact_vector<T, N, A>::compact_vector(const compact_vector& rhs)
+    {
+        assign(rhs.begin(), rhs.end());
+    }
+
+    template <class T, std::size_t N, class A>
+    inline compact_vector<T, N, A>::compact_vector(compact_vector&& rhs) noexcept
+        : m_size(rhs.m_size)
+        , m_capacity(rhs.m_capacity)
+    {
+        if (rhs.on_stack())
+        {
+            copy_elements(rhs.m_data, m_size, m_data);
+        }
+        else
+        {
+            m_heap = rhs.m_heap;
+            rhs.m_capacity = static_cast<std::uint32_t>(N);
+        }
+        rhs.m_size = 0;
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::operator=(const compact_vector& rhs) -> compact_vector&
+    {
+        if (this != &rhs)
+        {
+            assign(rhs.begin(), rhs.end());
+        }
+        return *this;
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::operator=(compact_vector&& rhs) noexcept -> compact_vector&
+    {
+        if (this != &rhs)
+        {
+            if (rhs.on_stack())
+            {
+                // Keep our heap buffer if we have one, it is large enough
+                copy_elements(rhs.m_data, rhs.m_size, data());
+                m_size = rhs.m_size;
+            }
+            else
+            {
+                release();
+                m_heap = rhs.m_heap;
+                m_size = rhs.m_size;
+                m_capacity = rhs.m_capacity;
+                rhs.m_capacity = static_cast<std::uint32_t>(N);
+            }
+            rhs.m_size = 0;
+        }
+        return *this;
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::operator=(const std::vector<T>& rhs) -> compact_vector&
+    {
+        assign(rhs.begin(), rhs.end());
+        return *this;
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::operator=(std::initializer_list<T> il) -> compact_vector&
+    {
+        assign(il.begin(), il.end());
+        return *this;
+    }
+
+    template <class T, std::size_t N, class A>
+    inline void compact_vector<T, N, A>::assign(size_type n, const value_type& v)
+    {
+        if (n > capacity())
+        {
+            grow(n);
+        }
+        std::fill(data(), data() + n, v);
+        m_size = static_cast<std::uint32_t>(n);
+    }
+
+    template <class T, std::size_t N, class A>
+    template <class IT>
+    inline void compact_vector<T, N, A>::assign(IT other_begin, IT other_end)
+    {
+        size_type n = static_cast<size_type>(std::distance(other_begin, other_end));
+        if (n > capacity())
+        {
+            grow(n);
+        }
+        std::copy(other_begin, other_end, data());
+        m_size = static_cast<std::uint32_t>(n);
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::operator[](size_type idx) -> reference
+    {
+        return data()[idx];
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::operator[](size_type idx) const -> const_reference
+    {
+        return data()[idx];
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::at(size_type idx) -> reference
+    {
+        if (idx >= size())
+        {
+            XTENSOR_THROW(std::out_of_range, "Out of range in compact_vector access");
+        }
+        return this->operator[](idx);
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::at(size_type idx) const -> const_reference
+    {
+        if (idx >= size())
+        {
+            XTENSOR_THROW(std::out_of_range, "Out of range in compact_vector access");
+        }
+        return this->operator[](idx);
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::data() noexcept -> pointer
+    {
+        return on_stack() ? m_data : m_heap;
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::data() const noexcept -> const_pointer
+    {
+        return on_stack() ? m_data : m_heap;
+    }
+
+    template <class T, std::size_t N, class A>
+    inline void compact_vector<T, N, A>::push_back(const T& elt)
+    {
+        if (size() == capacity())
+        {
+            T tmp = elt;
+            grow(size() + 1);
+            data()[m_size++] = tmp;
+        }
+        else
+        {
+            data()[m_size++] = elt;
+        }
+    }
+
+    template <class T, std::size_t N, class A>
+    inline void compact_vector<T, N, A>::pop_back()
+    {
+        --m_size;
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::begin() noexcept -> iterator
+    {
+        return data();
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::begin() const noexcept -> const_iterator
+    {
+        return data();
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::cbegin() const noexcept -> const_iterator
+    {
+        return begin();
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::end() noexcept -> iterator
+    {
+        return data() + m_size;
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::end() const noexcept -> const_iterator
+    {
+        return data() + m_size;
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::cend() const noexcept -> const_iterator
+    {
+        return end();
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::rbegin() noexcept -> reverse_iterator
+    {
+        return reverse_iterator(end());
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::rbegin() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator(end());
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::crbegin() const noexcept -> const_reverse_iterator
+    {
+        return rbegin();
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::rend() noexcept -> reverse_iterator
+    {
+        return reverse_iterator(begin());
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::rend() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::crend() const noexcept -> const_reverse_iterator
+    {
+        return rend();
+    }
+
+    template <class T, std::size_t N, class A>
+    inline bool compact_vector<T, N, A>::empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::size() const noexcept -> size_type
+    {
+        return static_cast<size_type>(m_size);
+    }
+
+    template <class T, std::size_t N, class A>
+    inline void compact_vector<T, N, A>::resize(size_type n)
+    {
+        resize(n, value_type());
+    }
+
+    template <class T, std::size_t N, class A>
+    inline void compact_vector<T, N, A>::resize(size_type n, const value_type& v)
+    {
+        if (n > capacity())
+        {
+            grow(n);
+        }
+        if (n > size())
+        {
+            std::fill(end(), begin() + n, v);
+        }
+        m_size = static_cast<std::uint32_t>(n);
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::max_size() const noexcept -> size_type
+    {
+        return static_cast<size_type>((std::numeric_limits<std::uint32_t>::max)());
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::capacity() const noexcept -> size_type
+    {
+        return static_cast<size_type>(m_capacity);
+    }
+
+    template <class T, std::size_t N, class A>
+    inline void compact_vector<T, N, A>::reserve(size_type n)
+    {
+        if (n > capacity())
+        {
+            grow(n);
+        }
+    }
+
+    template <class T, std::size_t N, class A>
+    inline void compact_vector<T, N, A>::shrink_to_fit()
+    {
+        if (!on_stack() && size() <= N)
+        {
+            T* heap = m_heap;
+            std::copy(heap, heap + m_size, m_data);
+            A alloc;
+            alloc.deallocate(heap, capacity());
+            m_capacity = static_cast<std::uint32_t>(N);
+        }
+    }
+
+    template <class T, std::size_t N, class A>
+    inline void compact_vector<T, N, A>::clear() noexcept
+    {
+        m_size = 0;
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::front() -> reference
+    {
+        XTENSOR_ASSERT(!empty());
+        return data()[0];
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::front() const -> const_reference
+    {
+        XTENSOR_ASSERT(!empty());
+        return data()[0];
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::back() -> reference
+    {
+        XTENSOR_ASSERT(!empty());
+        return data()[m_size - 1];
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::back() const -> const_reference
+    {
+        XTENSOR_ASSERT(!empty());
+        return data()[m_size - 1];
+    }
+
+    template <class T, std::size_t N, class A>
+    inline bool compact_vector<T, N, A>::on_stack() const noexcept
+    {
+        return m_capacity == N;
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::erase(const_iterator cit) -> iterator
+    {
+        return erase(cit, cit + 1);
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::erase(const_iterator cfirst, const_iterator clast) -> iterator
+    {
+        iterator first = begin() + (cfirst - cbegin());
+        iterator last = begin() + (clast - cbegin());
+        std::copy(last, end(), first);
+        m_size -= static_cast<std::uint32_t>(last - first);
+        return first;
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::insert(const_iterator it, const T& elt) -> iterator
+    {
+        return insert(it, &elt, &elt + 1);
+    }
+
+    template <class T, std::size_t N, class A>
+    template <class It>
+    inline auto compact_vector<T, N, A>::insert(const_iterator pos, It first, It last) -> iterator
+    {
+        difference_type idx = pos - cbegin();
+        size_type count = static_cast<size_type>(std::distance(first, last));
+        if (count != 0)
+        {
+            // Copy the inserted range first, it may alias the content
+            compact_vector tmp(first, last);
+            if (size() + count > capacity())
+            {
+                grow(size() + count);
+            }
+            iterator ins = begin() + idx;
+            std::copy_backward(ins, end(), end() + count);
+            std::copy(tmp.begin(), tmp.end(), ins);
+            m_size += static_cast<std::uint32_t>(count);
+        }
+        return begin() + idx;
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::insert(const_iterator pos, std::initializer_list<T> l) -> iterator
+    {
+        return insert(pos, l.begin(), l.end());
+    }
+
+    template <class T, std::size_t N, class A>
+    inline void compact_vector<T, N, A>::swap(compact_vector& rhs) noexcept
+    {
+        compact_vector tmp(std::move(rhs));
+        rhs = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    template <class T, std::size_t N, class A>
+    inline auto compact_vector<T, N, A>::get_allocator() const noexcept -> allocator_type
+    {
+        return allocator_type();
+    }
+
+    template <class T, std::size_t N, class A>
+    inline void compact_vector<T, N, A>::grow(size_type min_capacity)
+    {
+        size_type new_capacity = (std::max)(2 * capacity(), min_capacity);
+        A alloc;
+        T* new_alloc = alloc.allocate(new_capacity);
+        copy_elements(data(), size(), new_alloc);
+        release();
+        m_heap = new_alloc;
+        m_capacity = static_cast<std::uint32_t>(new_capacity);
+    }
+
+    // A plain loop rather than std::copy, whose memcpy over the inline buffer
+    // triggers a false positive array-bounds warning on GCC 12
+    template <class T, std::size_t N, class A>
+    inline void compact_vector<T, N, A>::copy_elements(const T* first, size_type n, T* out) noexcept
+    {
+        for (size_type i = 0; i < n; ++i)
+        {
+            out[i] = first[i];
+        }
+    }
+
+    template <class T, std::size_t N, class A>
+    inline void compact_vector<T, N, A>::release() noexcept
+    {
+        if (!on_stack())
+        {
+            A alloc;
+            alloc.deallocate(m_heap, capacity());
+            m_capacity = static_cast<std::uint32_t>(N);
+        }
+    }
+
+    template <class T, std::size_t N, class A>
+    inline bool operator==(const std::vector<T>& lhs, const compact_vector<T, N, A>& rhs)
+    {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <class T, std::size_t N, class A>
+    inline bool operator==(const compact_vector<T, N, A>& lhs, const std::vector<T>& rhs)
+    {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <class T, std::size_t N, class A>
+    inline bool operator==(const compact_vector<T, N, A>& lhs, const compact_vector<T, N, A>& rhs)
+    {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <class T, std::size_t N, class A>
+    inline bool operator!=(const compact_vector<T, N, A>& lhs, const compact_vector<T, N, A>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <class T, std::size_t N, class A>
+    inline bool operator<(const compact_vector<T, N, A>& lhs, const compact_vector<T, N, A>& rhs)
+    {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template <class T, std::size_t N, class A>
+    inline bool operator<=(const compact_vector<T, N, A>& lhs, const compact_vector<T, N, A>& rhs)
+    {
+        return !(lhs > rhs);
+    }
+
+    template <class T, std::size_t N, class A>
+    inline bool operator>(const compact_vector<T, N, A>& lhs, const compact_vector<T, N, A>& rhs)
+    {
+        return rhs < lhs;
+    }
+
+    template <class T, std::size_t N, class A>
+    inline bool operator>=(const compact_vector<T, N, A>& lhs, const compact_vector<T, N, A>& rhs)
+    {
+        return !(lhs < rhs);
+    }
+
+    template <class T, std::size_t N, class A>
+    inline void swap(compact_vector<T, N, A>& lhs, compact_vector<T, N, A>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    template <class X, class T, std::size_t N, class A>
+    struct rebind_container<X, compact_vector<T, N, A>>
+    {
+        using traits = std::allocator_traits<A>;
+        using allocator = typename traits::template rebind_alloc<X>;
+        using type = compact_vector<X, N, allocator>;
+    };
+
     /**
      * This array class is modeled after ``std::array`` but adds optional alignment through a template
      * parameter.
@@ -110,6 +110,7 @@ namespace xt
         xtensor_container();
         xtensor_container(nested_initializer_list_t<value_type, N> t);
         explicit xtensor_container(const shape_type& shape, layout_type l = L);
+        explicit xtensor_container(const shape_type& shape, uninitialized_t, layout_type l = L);
         explicit xtensor_container(const shape_type& shape, const_reference value, layout_type l = L);
         explicit xtensor_container(const shape_type& shape, const strides_type& strides);
         explicit xtensor_container(const shape_type& shape, const strides_type& strides, const_reference value);
@@ -117,6 +118,8 @@ namespace xt
 
         template <class S = shape_type>
         static xtensor_container from_shape(S&& s);
+        template <class S = shape_type>
+        static xtensor_container from_shape(S&& s, uninitialized_t);
 
         ~xtensor_container() = default;
 
@@ -444,6 +447,26 @@ namespace xt
         base_type::resize(shape, l);
     }
 
+    /**
+     * Allocates an xtensor_container with the specified shape and layout_type
+     * without initializing its elements, not even those of a type with a
+     * non-trivial default constructor such as std::complex. Use it when
+     * every element is written right after the construction.
+     * @param shape the shape of the xtensor_container
+     * @param l the layout_type of the xtensor_container
+     * @sa is_uninitialized_safe
+     */
+    template <class EC, std::size_t N, layout_type L, class Tag>
+    inline xtensor_container<EC, N, L, Tag>::xtensor_container(
+        const shape_type& shape,
+        uninitialized_t,
+        layout_type l
+    )
+        : base_type()
+    {
+        base_type::resize(shape, l, uninitialized);
+    }
+
     /**
      * Allocates an xtensor_container with the specified shape and layout_type. Elements
      * are initialized to the specified value.
@@ -459,7 +482,7 @@ namespace xt
     )
         : base_type()
     {
-        base_type::resize(shape, l);
+        base_type::resize(shape, l, uninitialized);
         std::fill(m_storage.begin(), m_storage.end(), value);
     }
 
@@ -548,6 +571,21 @@ namespace xt
         return self_type(shape);
     }
 
+    /**
+     * Allocates and returns an xtensor_container with the specified shape,
+     * without initializing its elements.
+     * @param s the shape of the xtensor_container
+     */
+    template <class EC, std::size_t N, layout_type L, class Tag>
+    template <class S>
+    inline xtensor_container<EC, N, L, Tag>
+    xtensor_container<EC, N, L, Tag>::from_shape(S&& s, uninitialized_t)
+    {
+        XTENSOR_ASSERT_MSG(s.size() == N, "Cannot change dimension of xtensor.");
+        shape_type shape = xtl::forward_sequence<shape_type, S>(s);
+        return self_type(shape, uninitialized);
+    }
+
     //@}
 
     /**
@@ -11,9 +11,12 @@
 #define XTENSOR_ASSIGN_HPP
 
 #include <algorithm>
+#include <cstddef>
 #include <functional>
+#include <numeric>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <xtl/xcomplex.hpp>
 #include <xtl/xsequence.hpp>
@@ -24,6 +27,7 @@
 #include "../core/xstrides.hpp"
 #include "../core/xtensor_config.hpp"
 #include "../core/xtensor_forward.hpp"
+#include "../utils/xinstrumentation.hpp"
 #include "../utils/xutils.hpp"
 
 #if defined(XTENSOR_USE_TBB)
@@ -200,6 +204,36 @@ namespace xt
         static void run(E1& e1, const E2& e2);
     };
 
+    /**********************
+     * transpose_assigner *
+     **********************/
+
+    namespace transpose_assign_detail
+    {
+        struct tile_dims_t
+        {
+            bool can_do_transpose_assign;
+            std::size_t lhs_dim;
+            std::size_t rhs_dim;
+        };
+    }
+
+    // Copies an operand whose contiguous dimension differs from the one of the
+    // left hand side (transpose, swapaxes, moveaxis) tile by tile, so that both
+    // sides stay in cache.
+    template <bool transpose>
+    class transpose_assigner
+    {
+    public:
+
+        using tile_dims_t = transpose_assign_detail::tile_dims_t;
+        // can_do_transpose_assign, contiguous dimensions of the lhs and of the rhs
+        template <class E1, class E2>
+        static tile_dims_t get_tile_dims(const E1& e1, const E2& e2);
+        template <class E1, class E2>
+        static void run(E1& e1, const E2& e2, const tile_dims_t& tile_dims);
+    };
+
     /***********************************
      * Assign functions implementation *
      ***********************************/
@@ -250,6 +284,67 @@ namespace xt
      * xexpression_assigner implementation *
      ***************************************/
 
+    template <class D>
+    class xstrided_container;
+
+    namespace detail
+    {
+        // Every element of the lhs is written by the assignment that follows
+        // the resize, so the new storage does not need to be initialized.
+        template <class E, class S>
+        inline void resize_for_assign(E& e, S&& shape)
+        {
+            XTENSOR_INSTRUMENT(instrumentation::scoped_event event(instrumentation::event_kind::resize, "resize");)
+            if constexpr (std::is_base_of<xstrided_container<E>, E>::value)
+            {
+                e.resize(std::forward<S>(shape), uninitialized);
+            }
+            else
+            {
+                e.resize(std::forward<S>(shape));
+            }
+            XTENSOR_INSTRUMENT(event.set_size(e.size(), e.size() * sizeof(typename E::value_type));)
+        }
+
+        // Loop actually run by xexpression_assigner_base::assign_data, the
+        // strided loop falls back to the stepper when the strides do not allow it.
+        template <bool simd_strided_assign, bool transpose_assign, class E1, class E2>
+        inline instrumentation::assigner_path selected_assigner_path(E1& e1, const E2& e2, bool linear_assign)
+        {
+            if (linear_assign)
+            {
+                return instrumentation::assigner_path::linear;
+            }
+            else if (transpose_assign
+                     && transpose_assigner<transpose_assign>::get_tile_dims(e1, e2).can_do_transpose_assign)
+            {
+                return instrumentation::assigner_path::transpose;
+            }
+            else if (simd_strided_assign
+                     && strided_loop_assigner<simd_strided_assign>::get_loop_sizes(e1, e2).can_do_strided_assign)
+            {
+                return instrumentation::assigner_path::strided;
+            }
+            else
+            {
+                return instrumentation::assigner_path::stepper;
+            }
+        }
+
+        template <class T, class S>
+        inline T make_assign_temporary(const S& shape)
+        {
+            if constexpr (std::is_constructible<T, const S&, uninitialized_t>::value)
+            {
+                return T(shape, uninitialized);
+            }
+            else
+            {
+                return T(shape);
+            }
+        }
+    }
+
     namespace detail
     {
         template <class E1, class E2>
@@ -279,10 +374,50 @@ namespace xt
             return false;
         }
 
+        // Expressions that are not contiguous but whose SIMD interface reads their
+        // elements in linear order, such as index views, provide linear_gather()
+        template <class E, class = void>
+        struct has_linear_gather : std::false_type
+        {
+        };
+
+        template <class E>
+        struct has_linear_gather<E, void_t<decltype(std::declval<const E&>().linear_gather())>>
+            : std::true_type
+        {
+        };
+
+        template <class E>
+        inline bool is_linear_readable(const E& e)
+        {
+            if constexpr (has_linear_gather<E>::value)
+            {
+                return e.linear_gather();
+            }
+            else
+            {
+                return e.is_contiguous();
+            }
+        }
+
+        template <class F, class... CT>
+        inline bool is_linear_readable(const xfunction<F, CT...>& e)
+        {
+            return e.layout() != layout_type::dynamic
+                   && accumulate(
+                       [](bool r, const auto& exp)
+                       {
+                           return r && is_linear_readable(exp);
+                       },
+                       true,
+                       e.arguments()
+                   );
+        }
+
         template <class E1, class E2>
         inline bool linear_dynamic_layout(const E1& e1, const E2& e2)
         {
-            return e1.is_contiguous() && e2.is_contiguous()
+            return e1.is_contiguous() && is_linear_readable(e2)
                    && compute_layout(e1.layout(), e2.layout()) != layout_type::dynamic;
         }
 
@@ -308,6 +443,157 @@ namespace xt
                                           && has_step_leading<typename T::stepper>::value && stepper_deref();
         };
 
+        // Raw access to the elements through data() + data_offset() and strides()
+        template <class T, class = void>
+        struct has_raw_strided_data : std::false_type
+        {
+        };
+
+        template <class T>
+        struct has_raw_strided_data<
+            T,
+            void_t<
+                decltype(std::declval<T&>().data()),
+                decltype(std::declval<T&>().storage().data()),
+                decltype(std::declval<T&>().data_offset()),
+                decltype(std::declval<T&>().strides())>>
+            : std::conjunction<
+                  std::is_pointer<decltype(std::declval<T&>().data())>,
+                  std::is_pointer<decltype(std::declval<T&>().storage().data())>,
+                  std::is_same<
+                      std::remove_cv_t<std::remove_pointer_t<decltype(std::declval<T&>().data())>>,
+                      typename T::value_type>>
+        {
+        };
+
+        // Containers that can be written block by block through data() after a resize
+        template <class E>
+        struct has_block_storage : std::is_base_of<xstrided_container<E>, E>
+        {
+        };
+
+        // Elements of an expression as a contiguous buffer in the layout l
+        // (row_major or column_major), the expression is copied only when it
+        // has no such storage.
+        template <class E>
+        class contiguous_operand
+        {
+        public:
+
+            using value_type = typename E::value_type;
+
+            contiguous_operand(const E& e, layout_type l)
+            {
+                if constexpr (has_raw_strided_data<const E>::value)
+                {
+                    if (e.is_contiguous() && (e.layout() == l || e.dimension() <= 1))
+                    {
+                        p_data = e.data() + e.data_offset();
+                        return;
+                    }
+                }
+                m_copy.resize(e.size());
+                if (l == layout_type::row_major)
+                {
+                    std::copy(
+                        e.template cbegin<layout_type::row_major>(),
+                        e.template cend<layout_type::row_major>(),
+                        m_copy.begin()
+                    );
+                }
+                else
+                {
+                    std::copy(
+                        e.template cbegin<layout_type::column_major>(),
+                        e.template cend<layout_type::column_major>(),
+                        m_copy.begin()
+                    );
+                }
+                p_data = m_copy.data();
+            }
+
+            // Moving keeps the buffer of the copy, p_data stays valid
+            contiguous_operand(const contiguous_operand&) = delete;
+            contiguous_operand& operator=(const contiguous_operand&) = delete;
+            contiguous_operand(contiguous_operand&&) = default;
+            contiguous_operand& operator=(contiguous_operand&&) = default;
+
+            const value_type* data() const noexcept
+            {
+                return p_data;
+            }
+
+        private:
+
+            uvector<value_type> m_copy;
+            const value_type* p_data = nullptr;
+        };
+
+        // Row major description of a row_major or column_major buffer, a column
+        // major buffer being the row major buffer of the reversed shape. The
+        // dimensions are given in this block order.
+        struct block_layout
+        {
+            template <class S>
+            block_layout(const S& s, layout_type l)
+                : shape(s.cbegin(), s.cend())
+                , size(shape.size() + 1, std::size_t(1))
+                , reversed(l == layout_type::column_major)
+            {
+                if (reversed)
+                {
+                    std::reverse(shape.begin(), shape.end());
+                }
+                for (std::size_t d = shape.size(); d-- > 0;)
+                {
+                    size[d] = size[d + 1] * shape[d];
+                }
+            }
+
+            // Block dimension of the axis a of the shape
+            std::size_t axis(std::size_t a) const noexcept
+            {
+                return reversed ? shape.size() - 1 - a : a;
+            }
+
+            // Values given per axis of the shape, in block order
+            template <class V>
+            std::vector<std::size_t> order(const V& v) const
+            {
+                std::vector<std::size_t> res(v.cbegin(), v.cend());
+                if (reversed)
+                {
+                    std::reverse(res.begin(), res.end());
+                }
+                return res;
+            }
+
+            // Number of elements in the dimensions before d
+            std::size_t outer(std::size_t d) const
+            {
+                return std::accumulate(shape.cbegin(), shape.cbegin() + std::ptrdiff_t(d), std::size_t(1), std::multiplies<std::size_t>());
+            }
+
+            std::vector<std::size_t> shape;
+            // number of elements in the dimensions d and after
+            std::vector<std::size_t> size;
+            bool reversed;
+        };
+
+        // Copies the first block of dst over the n - 1 following ones, doubling
+        // the copied range at each step.
+        template <class T>
+        inline void replicate_block(T* dst, std::size_t block_size, std::size_t n)
+        {
+            std::size_t filled = 1;
+            while (filled < n)
+            {
+                const std::size_t count = std::min(filled, n - filled);
+                std::copy(dst, dst + count * block_size, dst + filled * block_size);
+                filled += count;
+            }
+        }
+
         template <class T>
         struct use_strided_loop<xscalar<T>>
         {
@@ -431,6 +717,13 @@ namespace xt
             return simd_assign() && detail::linear_dynamic_layout(e1, e2);
         }
 
+        static constexpr bool transpose_assign()
+        {
+            return detail::has_raw_strided_data<E1>::value && detail::has_raw_strided_data<const E2>::value
+                   && std::is_same<e1_value_type, e2_value_type>::value
+                   && std::is_trivially_copyable<e1_value_type>::value;
+        }
+
         using e2_requested_value_type = std::
             conditional_t<is_bool<e2_value_type>::value, typename E2::bool_load_type, e2_value_type>;
         using requested_value_type = detail::conditional_promote_to_complex_t<e1_value_type, e2_requested_value_type>;
@@ -451,6 +744,20 @@ namespace xt
         constexpr bool simd_assign = traits::simd_assign();
         constexpr bool simd_linear_assign = traits::simd_linear_assign();
         constexpr bool simd_strided_assign = traits::simd_strided_assign();
+        constexpr bool transpose_assign = traits::transpose_assign();
+        XTENSOR_INSTRUMENT(
+            instrumentation::scoped_event event(
+                instrumentation::event_kind::assignment,
+                "assign_data",
+                de1.size(),
+                de1.size() * sizeof(typename E1::value_type)
+            );
+            event.set_path(detail::selected_assigner_path<simd_strided_assign, transpose_assign>(
+                de1,
+                de2,
+                linear_assign
+            ));
+        )
         if (linear_assign)
         {
             if (simd_linear_assign || traits::simd_linear_assign(de1, de2))
@@ -467,13 +774,21 @@ namespace xt
                 linear_assigner<false>::run(de1, de2);
             }
         }
-        else if (simd_strided_assign)
-        {
-            strided_loop_assigner<simd_strided_assign>::run(de1, de2);
-        }
         else
         {
-            stepper_assigner<E1, E2, default_assignable_layout(E1::static_layout)>(de1, de2).run();
+            const auto tile_dims = transpose_assigner<transpose_assign>::get_tile_dims(de1, de2);
+            if (tile_dims.can_do_transpose_assign)
+            {
+                transpose_assigner<transpose_assign>::run(de1, de2, tile_dims);
+            }
+            else if (simd_strided_assign)
+            {
+                strided_loop_assigner<simd_strided_assign>::run(de1, de2);
+            }
+            else
+            {
+                stepper_assigner<E1, E2, default_assignable_layout(E1::static_layout)>(de1, de2).run();
+            }
         }
     }
 
@@ -512,7 +827,7 @@ namespace xt
                 comperator_type()
             ))
         {
-            typename E1::temporary_type tmp(shape);
+            auto tmp = detail::make_assign_temporary<typename E1::temporary_type>(shape);
             base_type::assign_data(tmp, e2, trivial_broadcast);
             de1.assign_temporary(std::move(tmp));
         }
@@ -574,7 +889,7 @@ namespace xt
         // If our RHS is not a xfunction, we know that the RHS is at least potentially trivial
         // We check the strides of the RHS in detail::is_trivial_broadcast to see if they match up!
         // So we can skip a shape copy and a call to broadcast_shape(...)
-        e1.resize(e2.shape());
+        detail::resize_for_assign(e1, e2.shape());
         return true;
     }
 
@@ -589,7 +904,7 @@ namespace xt
              * at compile time plus we can resize right away.
              */
             // resize in case LHS is not a fixed size container. If it is, this is a NOP
-            e1.resize(typename xfunction<F, CT...>::shape_type{});
+            detail::resize_for_assign(e1, typename xfunction<F, CT...>::shape_type{});
             return detail::static_trivial_broadcast<
                 detail::is_fixed<typename xfunction<F, CT...>::shape_type>::value,
                 CT...>::value;
@@ -601,7 +916,7 @@ namespace xt
             size_type size = e2.dimension();
             index_type shape = uninitialized_shape<index_type>(size);
             bool trivial_broadcast = e2.broadcast_shape(shape, true);
-            e1.resize(std::move(shape));
+            detail::resize_for_assign(e1, std::move(shape));
             return trivial_broadcast;
         }
     }
@@ -948,6 +1263,16 @@ namespace xt
             }
         };
 
+        template <class T>
+        struct is_xstepper : std::false_type
+        {
+        };
+
+        template <class C>
+        struct is_xstepper<xstepper<C>> : std::true_type
+        {
+        };
+
         template <layout_type L, class S>
         struct check_strides_functor
         {
@@ -964,6 +1289,11 @@ namespace xt
             {
                 // All dimenions less than var have differing strides
                 auto var = check_strides_overlap<layout_type::row_major>::get(m_strides, el.strides());
+                if constexpr (is_xstepper<typename T::const_stepper>::value)
+                {
+                    // Strided steppers gather the inner dimension whatever its stride
+                    var = std::min(var, m_strides.size() - 1);
+                }
                 if (var > m_cut)
                 {
                     m_cut = var;
@@ -1145,6 +1475,9 @@ namespace xt
         {
             step_dim = cut;
         }
+        // The right hand side is stepped along this dimension explicitly, since
+        // its stride may differ from the one of the contiguous left hand side.
+        const std::size_t leading_dim = is_row_major ? e1.dimension() - 1 : 0;
 #if defined(XTENSOR_USE_OPENMP) && defined(strided_parallel_assign)
         if (outer_loop_size >= XTENSOR_OPENMP_TRESHOLD / inner_loop_size)
         {
@@ -1168,13 +1501,13 @@ namespace xt
 
                 for (std::size_t i = 0; i < simd_size; ++i)
                 {
-                    res_stepper.store_simd(fct_stepper.template step_simd<value_type>());
+                    res_stepper.store_simd(fct_stepper.template step_simd<value_type>(leading_dim));
                 }
                 for (std::size_t i = 0; i < simd_rest; ++i)
                 {
                     *(res_stepper) = conditional_cast<needs_cast, e1_value_type>(*(fct_stepper));
                     res_stepper.step_leading();
-                    fct_stepper.step_leading();
+                    fct_stepper.step(leading_dim);
                 }
 
                 // next unaligned index
@@ -1211,7 +1544,7 @@ namespace xt
             tbb::static_partitioner sp;
             tbb::parallel_for(
                 tbb::blocked_range<size_t>(0ul, outer_loop_size),
-                [&e1, &e2, is_row_major, step_dim, simd_size, simd_rest, &max_shape, &idx_ = idx](
+                [&e1, &e2, is_row_major, step_dim, leading_dim, simd_size, simd_rest, &max_shape, &idx_ = idx](
                     const tbb::blocked_range<size_t>& r
                 )
                 {
@@ -1243,13 +1576,13 @@ namespace xt
 
                         for (std::size_t i = 0; i < simd_size; ++i)
                         {
-                            res_stepper.store_simd(fct_stepper.template step_simd<value_type>());
+                            res_stepper.store_simd(fct_stepper.template step_simd<value_type>(leading_dim));
                         }
                         for (std::size_t i = 0; i < simd_rest; ++i)
                         {
                             *(res_stepper) = conditional_cast<needs_cast, e1_value_type>(*(fct_stepper));
                             res_stepper.step_leading();
-                            fct_stepper.step_leading();
+                            fct_stepper.step(leading_dim);
                         }
 
                         // next unaligned index
@@ -1289,13 +1622,13 @@ namespace xt
             {
                 for (std::size_t i = 0; i < simd_size; ++i)
                 {
-                    res_stepper.store_simd(fct_stepper.template step_simd<value_type>());
+                    res_stepper.store_simd(fct_stepper.template step_simd<value_type>(leading_dim));
                 }
                 for (std::size_t i = 0; i < simd_rest; ++i)
                 {
                     *(res_stepper) = conditional_cast<needs_cast, e1_value_type>(*(fct_stepper));
                     res_stepper.step_leading();
-                    fct_stepper.step_leading();
+                    fct_stepper.step(leading_dim);
                 }
 
                 is_row_major
@@ -1356,6 +1689,164 @@ namespace xt
         // trigger the fallback assigner
         stepper_assigner<E1, E2, default_assignable_layout(E1::static_layout)>(e1, e2).run();
     }
+
+    /*************************************
+     * transpose_assigner implementation *
+     *************************************/
+
+    namespace transpose_assign_detail
+    {
+        // Edge of the square tiles, a tile of each side fits together in a 32 kB L1 cache
+        template <class T>
+        constexpr std::size_t tile_size()
+        {
+            return sizeof(T) <= 4 ? std::size_t(64) : std::size_t(32);
+        }
+
+        // Contiguous extents shorter than this are left to the other loops
+        constexpr std::size_t min_extent = 16;
+
+        template <class E>
+        inline std::size_t unit_stride_dim(const E& e)
+        {
+            const auto& shape = e.shape();
+            const auto& strides = e.strides();
+            for (std::size_t d = e.dimension(); d-- > 0;)
+            {
+                if (static_cast<std::ptrdiff_t>(strides[d]) == 1 && shape[d] > 1)
+                {
+                    return d;
+                }
+            }
+            return e.dimension();
+        }
+
+        // Copies the rows [y0, y1) of a tile column, dst is contiguous along x
+        // and src along y.
+        template <class T>
+        inline void copy_tiles(
+            T* dst,
+            const T* src,
+            std::size_t nx,
+            std::size_t y0,
+            std::size_t y1,
+            std::ptrdiff_t dst_stride,
+            std::ptrdiff_t src_stride
+        )
+        {
+            constexpr std::size_t tile = tile_size<T>();
+            for (std::size_t x0 = 0; x0 < nx; x0 += tile)
+            {
+                const std::size_t x1 = std::min(x0 + tile, nx);
+                for (std::size_t y = y0; y < y1; ++y)
+                {
+                    T* d = dst + static_cast<std::ptrdiff_t>(y) * dst_stride;
+                    const T* s = src + static_cast<std::ptrdiff_t>(y);
+                    for (std::size_t x = x0; x < x1; ++x)
+                    {
+                        d[x] = s[static_cast<std::ptrdiff_t>(x) * src_stride];
+                    }
+                }
+            }
+        }
+    }
+
+    template <bool transpose>
+    template <class E1, class E2>
+    inline auto transpose_assigner<transpose>::get_tile_dims(const E1& e1, const E2& e2) -> tile_dims_t
+    {
+        tile_dims_t res = {false, 0, 0};
+        const std::size_t dim = e1.dimension();
+        if (dim < 2 || e2.dimension() != dim
+            || !std::equal(e1.shape().cbegin(), e1.shape().cend(), e2.shape().cbegin()))
+        {
+            return res;
+        }
+        res.lhs_dim = transpose_assign_detail::unit_stride_dim(e1);
+        res.rhs_dim = transpose_assign_detail::unit_stride_dim(e2);
+        res.can_do_transpose_assign = res.lhs_dim != dim && res.rhs_dim != dim && res.lhs_dim != res.rhs_dim
+                                      && e1.shape()[res.lhs_dim] >= transpose_assign_detail::min_extent
+                                      && e1.shape()[res.rhs_dim] >= transpose_assign_detail::min_extent;
+        return res;
+    }
+
+    template <bool transpose>
+    template <class E1, class E2>
+    inline void transpose_assigner<transpose>::run(E1& e1, const E2& e2, const tile_dims_t& tile_dims)
+    {
+        using value_type = typename E1::value_type;
+        constexpr std::size_t tile = transpose_assign_detail::tile_size<value_type>();
+
+        const auto& shape = e1.shape();
+        const std::size_t nx = shape[tile_dims.lhs_dim];
+        const std::size_t ny = shape[tile_dims.rhs_dim];
+        const auto dst_stride = static_cast<std::ptrdiff_t>(e1.strides()[tile_dims.rhs_dim]);
+        const auto src_stride = static_cast<std::ptrdiff_t>(e2.strides()[tile_dims.lhs_dim]);
+
+        // The remaining dimensions are traversed with a flat index
+        std::vector<std::size_t> outer_shape;
+        std::vector<std::ptrdiff_t> dst_outer_strides;
+        std::vector<std::ptrdiff_t> src_outer_strides;
+        std::size_t outer_size = 1;
+        for (std::size_t d = 0; d < e1.dimension(); ++d)
+        {
+            if (d != tile_dims.lhs_dim && d != tile_dims.rhs_dim)
+            {
+                outer_shape.push_back(shape[d]);
+                dst_outer_strides.push_back(static_cast<std::ptrdiff_t>(e1.strides()[d]));
+                src_outer_strides.push_back(static_cast<std::ptrdiff_t>(e2.strides()[d]));
+                outer_size *= shape[d];
+            }
+        }
+
+        value_type* dst = e1.data() + static_cast<std::ptrdiff_t>(e1.data_offset());
+        const value_type* src = e2.data() + static_cast<std::ptrdiff_t>(e2.data_offset());
+        const std::size_t y_tiles = (ny + tile - 1) / tile;
+
+        xt::detail::parallel_chunks(
+            outer_size * y_tiles,
+            outer_size * nx * ny,
+            [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t w = first; w < last; ++w)
+                {
+                    std::size_t outer = w / y_tiles;
+                    const std::size_t y0 = (w % y_tiles) * tile;
+                    std::ptrdiff_t dst_offset = 0;
+                    std::ptrdiff_t src_offset = 0;
+                    for (std::size_t i = outer_shape.size(); i-- > 0;)
+                    {
+                        const auto idx = static_cast<std::ptrdiff_t>(outer % outer_shape[i]);
+                        outer /= outer_shape[i];
+                        dst_offset += idx * dst_outer_strides[i];
+                        src_offset += idx * src_outer_strides[i];
+                    }
+                    transpose_assign_detail::copy_tiles(
+                        dst + dst_offset,
+                        src + src_offset,
+                        nx,
+                        y0,
+                        std::min(y0 + tile, ny),
+                        dst_stride,
+                        src_stride
+                    );
+                }
+            }
+        );
+    }
+
+    template <>
+    template <class E1, class E2>
+    inline auto transpose_assigner<false>::get_tile_dims(const E1&, const E2&) -> tile_dims_t
+    {
+        return {false, 0, 0};
+    }
+
+    template <>
+    template <class E1, class E2>
+    inline void transpose_assigner<false>::run(E1&, const E2&, const tile_dims_t&)
+    {
+    }
 }
 
 #endif
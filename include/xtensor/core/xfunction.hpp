@@ -474,6 +474,9 @@ namespace xt
         template <class T>
         simd_return_type<T> step_simd();
 
+        template <class T>
+        simd_return_type<T> step_simd(size_type dim);
+
         void step_leading();
 
     private:
@@ -1130,6 +1133,19 @@ namespace xt
         );
     }
 
+    template <class F, class... CT>
+    template <class T>
+    inline auto xfunction_stepper<F, CT...>::step_simd(size_type dim) -> simd_return_type<T>
+    {
+        return std::apply(
+            [&](auto&... st)
+            {
+                return (p_f->m_f.simd_apply)(st.template step_simd<T>(dim)...);
+            },
+            m_st
+        );
+    }
+
     template <class F, class... CT>
     inline void xfunction_stepper<F, CT...>::step_leading()
     {
@@ -136,6 +136,9 @@ namespace xt
         template <class T>
         simd_return_type<T> step_simd();
 
+        template <class T>
+        simd_return_type<T> step_simd(size_type dim);
+
         void step_leading();
 
         template <class R>
@@ -571,6 +574,43 @@ namespace xt
         return reg;
     }
 
+    /**
+     * Loads the next batch of elements along the dimension \c dim. When the
+     * stride of this dimension is not 1, as in stepped or column slices, the
+     * elements are gathered into a buffer and loaded from there.
+     */
+    template <class C>
+    template <class T>
+    inline auto xstepper<C>::step_simd(size_type dim) -> simd_return_type<T>
+    {
+        difference_type stride = 0;
+        if (dim >= m_offset)
+        {
+            stride = static_cast<difference_type>(p_c->strides()[dim - m_offset]);
+        }
+        if (stride == 1)
+        {
+            return step_simd<T>();
+        }
+
+        using simd_type = simd_return_type<T>;
+        constexpr std::size_t simd_size = xt_simd::revert_simd_traits<simd_type>::size;
+        std::array<value_type, simd_size> buffer;
+        if (stride == 0)
+        {
+            buffer.fill(*m_it);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < simd_size; ++i)
+            {
+                buffer[i] = *(m_it + static_cast<difference_type>(i) * stride);
+            }
+            m_it += static_cast<difference_type>(simd_size) * stride;
+        }
+        return detail::step_simd_invoker<const value_type*>::template apply<simd_type>(buffer.data());
+    }
+
     template <class C>
     template <class R>
     inline void xstepper<C>::store_simd(const R& vec)
@@ -18,7 +18,11 @@
 #include <array>
 #include <cmath>
 #include <complex>
+#include <cstddef>
+#include <memory>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <xtl/xcomplex.hpp>
 #include <xtl/xsequence.hpp>
@@ -27,6 +31,7 @@
 #include "../core/xeval.hpp"
 #include "../core/xoperation.hpp"
 #include "../core/xtensor_config.hpp"
+#include "../misc/xfft_plan.hpp"
 #include "../misc/xmanipulation.hpp"
 #include "../reducers/xaccumulator.hpp"
 #include "../reducers/xreducer.hpp"
@@ -3211,47 +3216,281 @@ namespace xt
         struct full
         {
         };
+
+        struct same
+        {
+        };
     }
 
+    /**
+     * Algorithm used to compute a 1D convolution. ``automatic`` picks the
+     * cheapest one from the lengths of the operands: ``direct`` for short
+     * kernels, ``fft`` when both operands are long, ``overlap_add`` for long
+     * signals with medium kernels. FFT based methods require floating point
+     * or complex values, ``direct`` is used for other value types.
+     */
+    enum class convolve_method
+    {
+        automatic,
+        direct,
+        fft,
+        overlap_add
+    };
+
     namespace detail
     {
-        template <class E1, class E2>
-        inline auto convolve_impl(E1&& e1, E2&& e2, convolve_mode::valid)
+        // [first, last) part of the full convolution kept by each mode, na >= nv
+        inline std::pair<std::size_t, std::size_t> convolve_range(std::size_t na, std::size_t nv, convolve_mode::full)
+        {
+            return {0, na + nv - 1};
+        }
+
+        inline std::pair<std::size_t, std::size_t> convolve_range(std::size_t na, std::size_t nv, convolve_mode::same)
+        {
+            return {(nv - 1) / 2, (nv - 1) / 2 + na};
+        }
+
+        inline std::pair<std::size_t, std::size_t> convolve_range(std::size_t na, std::size_t nv, convolve_mode::valid)
         {
-            using value_type = typename std::decay<E1>::type::value_type;
+            return {nv - 1, na};
+        }
+
+        template <class T>
+        struct is_fft_convolvable : std::is_floating_point<T>
+        {
+        };
 
-            const std::size_t na = e1.size();
-            const std::size_t nv = e2.size();
-            const std::size_t n = na - nv + 1;
-            xt::xtensor<value_type, 1> out = xt::zeros<value_type>({n});
-            for (std::size_t i = 0; i < n; i++)
+        template <class T>
+        struct is_fft_convolvable<std::complex<T>> : std::is_floating_point<T>
+        {
+        };
+
+        // Direct convolution computed as one contiguous multiply-add loop per
+        // kernel element, which the compiler vectorizes.
+        template <class T>
+        inline void
+        convolve_direct(const T* a, std::size_t na, const T* v, std::size_t nv, T* out, std::size_t first, std::size_t last)
+        {
+            std::fill(out, out + (last - first), T(0));
+            for (std::size_t j = 0; j < nv; ++j)
             {
-                for (std::size_t j = 0; j < nv; j++)
+                const std::size_t begin = std::max(first, j);
+                const std::size_t end = std::min(last, j + na);
+                if (begin < end)
                 {
-                    out(i) += e1(j) * e2(j + i);
+                    const T w = v[j];
+                    const T* src = a + (begin - j);
+                    T* dst = out + (begin - first);
+                    const std::size_t count = end - begin;
+                    for (std::size_t k = 0; k < count; ++k)
+                    {
+                        dst[k] += w * src[k];
+                    }
                 }
             }
-            return out;
         }
 
-        template <class E1, class E2>
-        inline auto convolve_impl(E1&& e1, E2&& e2, convolve_mode::full)
+        // Zero-padded transforms of size n for the FFT based convolutions, real
+        // values go through the half-length real transform.
+        template <class T>
+        class convolution_transform
+        {
+        public:
+
+            using spectrum_type = std::vector<std::complex<xtl::complex_value_type_t<T>>>;
+
+            explicit convolution_transform(std::size_t n)
+                : m_size(n)
+                , m_buffer(xtl::is_complex<T>::value ? 0 : n)
+            {
+                if constexpr (xtl::is_complex<T>::value)
+                {
+                    m_plan = fft::get_plan<typename T::value_type>(n);
+                }
+                else
+                {
+                    m_plan = fft::get_rfft_plan<T>(n);
+                }
+            }
+
+            std::size_t size() const noexcept
+            {
+                return m_size;
+            }
+
+            spectrum_type forward(const T* x, std::size_t count)
+            {
+                spectrum_type res(spectrum_size());
+                forward(x, count, res);
+                return res;
+            }
+
+            void forward(const T* x, std::size_t count, spectrum_type& res)
+            {
+                if constexpr (xtl::is_complex<T>::value)
+                {
+                    std::copy(x, x + count, res.begin());
+                    std::fill(res.begin() + static_cast<std::ptrdiff_t>(count), res.end(), T(0));
+                    m_plan->forward(res.data());
+                }
+                else
+                {
+                    std::copy(x, x + count, m_buffer.begin());
+                    std::fill(m_buffer.begin() + static_cast<std::ptrdiff_t>(count), m_buffer.end(), T(0));
+                    m_plan->forward(m_buffer.data(), res.data());
+                }
+            }
+
+            // Multiplies spec by kernel and returns a pointer to the size()
+            // values of the normalized inverse transform of the product.
+            const T* convolve(spectrum_type& spec, const spectrum_type& kernel)
+            {
+                using real_type = xtl::complex_value_type_t<T>;
+                const real_type scale = real_type(1) / static_cast<real_type>(m_size);
+                for (std::size_t k = 0; k < spec.size(); ++k)
+                {
+                    spec[k] *= kernel[k] * scale;
+                }
+                if constexpr (xtl::is_complex<T>::value)
+                {
+                    m_plan->backward(spec.data());
+                    return spec.data();
+                }
+                else
+                {
+                    m_plan->backward(spec.data(), m_buffer.data());
+                    return m_buffer.data();
+                }
+            }
+
+        private:
+
+            std::size_t spectrum_size() const noexcept
+            {
+                return xtl::is_complex<T>::value ? m_size : m_size / 2 + 1;
+            }
+
+            using plan_type = std::conditional_t<
+                xtl::is_complex<T>::value,
+                fft::fft_plan<xtl::complex_value_type_t<T>>,
+                fft::rfft_plan<xtl::complex_value_type_t<T>>>;
+
+            std::size_t m_size;
+            std::vector<T> m_buffer;
+            std::shared_ptr<const plan_type> m_plan;
+        };
+
+        template <class T>
+        inline void
+        convolve_fft(const T* a, std::size_t na, const T* v, std::size_t nv, T* out, std::size_t first, std::size_t last)
+        {
+            convolution_transform<T> transform(fft::next_fast_length(na + nv - 1));
+            auto kernel = transform.forward(v, nv);
+            auto spec = transform.forward(a, na);
+            const T* res = transform.convolve(spec, kernel);
+            std::copy(res + first, res + last, out);
+        }
+
+        // FFT size of the overlap-add blocks for a kernel of length nv
+        inline std::size_t overlap_add_length(std::size_t nv)
+        {
+            return fft::next_fast_length(std::max(std::size_t(8) * nv, std::size_t(256)));
+        }
+
+        // Overlap-add: the signal is cut in blocks of n - nv + 1 samples whose
+        // linear convolutions with the kernel, computed by FFTs of size n, are
+        // accumulated in the output.
+        template <class T>
+        inline void convolve_overlap_add(
+            const T* a,
+            std::size_t na,
+            const T* v,
+            std::size_t nv,
+            T* out,
+            std::size_t first,
+            std::size_t last
+        )
+        {
+            convolution_transform<T> transform(overlap_add_length(nv));
+            const std::size_t step = transform.size() - nv + 1;
+            auto kernel = transform.forward(v, nv);
+            auto spec = kernel;
+            std::fill(out, out + (last - first), T(0));
+            for (std::size_t start = 0; start < na; start += step)
+            {
+                const std::size_t count = std::min(step, na - start);
+                // the block contributes to [start, start + count + nv - 1)
+                const std::size_t begin = std::max(first, start);
+                const std::size_t end = std::min(last, start + count + nv - 1);
+                if (begin < end)
+                {
+                    transform.forward(a + start, count, spec);
+                    const T* res = transform.convolve(spec, kernel);
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        out[i - first] += res[i - start];
+                    }
+                }
+            }
+        }
+
+        inline convolve_method select_convolve_method(std::size_t na, std::size_t nv)
+        {
+            if (nv <= 32)
+            {
+                return convolve_method::direct;
+            }
+            // Rough operation counts, an FFT point costs about as much as a couple of
+            // vectorized multiply-adds of the direct method.
+            auto fft_cost = [](std::size_t n)
+            {
+                return 2. * static_cast<double>(n) * std::log2(static_cast<double>(n));
+            };
+            const double direct_cost = static_cast<double>(na) * static_cast<double>(nv);
+            const double full_cost = 3. * fft_cost(fft::next_fast_length(na + nv - 1));
+            const std::size_t block = overlap_add_length(nv);
+            const double blocks = std::ceil(static_cast<double>(na) / static_cast<double>(block - nv + 1));
+            const double overlap_add_cost = (2. * blocks + 1.) * fft_cost(block);
+            if (direct_cost <= full_cost && direct_cost <= overlap_add_cost)
+            {
+                return convolve_method::direct;
+            }
+            return full_cost <= overlap_add_cost ? convolve_method::fft : convolve_method::overlap_add;
+        }
+
+        template <class T, class M>
+        inline auto convolve_impl(const xt::xtensor<T, 1>& a, const xt::xtensor<T, 1>& v, M mode, convolve_method method)
         {
-            using value_type = typename std::decay<E1>::type::value_type;
+            const std::size_t na = a.size();
+            const std::size_t nv = v.size();
+            const auto range = convolve_range(na, nv, mode);
+            auto out = xt::xtensor<T, 1>::from_shape({range.second - range.first}, uninitialized);
+            if constexpr (is_fft_convolvable<T>::value)
+            {
+                if (method == convolve_method::automatic)
+                {
+                    method = select_convolve_method(na, nv);
+                }
+            }
+            else
+            {
+                method = convolve_method::direct;
+            }
 
-            const std::size_t na = e1.size();
-            const std::size_t nv = e2.size();
-            const std::size_t n = na + nv - 1;
-            xt::xtensor<value_type, 1> out = xt::zeros<value_type>({n});
-            for (std::size_t i = 0; i < n; i++)
+            if constexpr (is_fft_convolvable<T>::value)
             {
-                const std::size_t jmn = (i >= nv - 1) ? i - (nv - 1) : 0;
-                const std::size_t jmx = (i < na - 1) ? i : na - 1;
-                for (std::size_t j = jmn; j <= jmx; ++j)
+                if (method == convolve_method::fft)
+                {
+                    convolve_fft(a.data(), na, v.data(), nv, out.data(), range.first, range.second);
+                    return out;
+                }
+                else if (method == convolve_method::overlap_add)
                 {
-                    out(i) += e1(j) * e2(i - j);
+                    convolve_overlap_add(a.data(), na, v.data(), nv, out.data(), range.first, range.second);
+                    return out;
                 }
             }
+            convolve_direct(a.data(), na, v.data(), nv, out.data(), range.first, range.second);
             return out;
         }
     }
@@ -3262,12 +3501,13 @@ namespace xt
      * @param a 1D expression
      * @param v 1D expression
      * @param mode placeholder Select algorithm #convolve_mode
+     * @param method algorithm used to compute the convolution, see #convolve_method
      *
-     * @detail the algorithm convolves a with v and will incur a copy overhead
-     *   should v be longer than a.
+     * @detail both expressions are first evaluated into contiguous tensors of
+     *   their common value type; the longest one is convolved with the other.
      */
     template <class E1, class E2, class E3>
-    inline auto convolve(E1&& a, E2&& v, E3 mode)
+    inline auto convolve(E1&& a, E2&& v, E3 mode, convolve_method method = convolve_method::automatic)
     {
         if (a.dimension() != 1 || v.dimension() != 1)
         {
@@ -3276,17 +3516,22 @@ namespace xt
 
         XTENSOR_ASSERT(a.size() > 0 && v.size() > 0);
 
+        using value_type = std::common_type_t<
+            typename std::decay_t<E1>::value_type,
+            typename std::decay_t<E2>::value_type>;
+        xt::xtensor<value_type, 1> ea = std::forward<E1>(a);
+        xt::xtensor<value_type, 1> ev = std::forward<E2>(v);
+
         // swap them so a is always the longest one
-        if (a.size() < v.size())
+        if (ea.size() < ev.size())
         {
-            return detail::convolve_impl(std::forward<E2>(v), std::forward<E1>(a), mode);
+            return detail::convolve_impl(ev, ea, mode, method);
         }
         else
         {
-            return detail::convolve_impl(std::forward<E1>(a), std::forward<E2>(v), mode);
+            return detail::convolve_impl(ea, ev, mode, method);
         }
     }
 }
 
-
 #endif
@@ -10,6 +10,11 @@
 #ifndef XTENSOR_XMULTIINDEX_ITERATOR
 #define XTENSOR_XMULTIINDEX_ITERATOR
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#include "../utils/xutils.hpp"
 #include "../views/xstrided_view.hpp"
 #include "xtl/xsequence.hpp"
 
@@ -126,6 +131,261 @@ namespace xt
         );
     }
 
+    /*********************
+     * xmultiindex_range *
+     *********************/
+
+    /**
+     * @class xmultiindex_range
+     * @brief Multi-indices of a region of fixed rank.
+     *
+     * Holds the indices of [first, last) in row major order. Iterating with
+     * begin() and end() goes through xmultiindex_iterator, for_each runs nested
+     * loops instead: the depth is known at compile time, the last index is
+     * incremented in an unrolled loop and the other ones only when it wraps.
+     * The range can be split along its first dimension to share the iterations
+     * between threads.
+     *
+     * @tparam N the rank of the indices
+     * @sa multiindex_range
+     */
+    template <std::size_t N>
+    class xmultiindex_range
+    {
+    public:
+
+        using self_type = xmultiindex_range<N>;
+        using index_type = std::array<std::size_t, N>;
+        using size_type = std::size_t;
+        using iterator = xmultiindex_iterator<index_type>;
+        using const_iterator = iterator;
+
+        xmultiindex_range(const index_type& first, const index_type& last) noexcept;
+
+        const index_type& first() const noexcept;
+        const index_type& last() const noexcept;
+
+        size_type size() const noexcept;
+        bool empty() const noexcept;
+
+        iterator begin() const;
+        iterator end() const;
+
+        self_type split(size_type part, size_type parts) const
+            requires(N > 0);
+
+        template <class F>
+        void for_each(F&& f) const;
+
+        template <class F>
+        void parallel_for_each(F&& f) const;
+
+    private:
+
+        template <std::size_t D, class F>
+        void loop(index_type& index, F& f) const;
+
+        index_type m_first;
+        index_type m_last;
+    };
+
+    template <class I, std::size_t N>
+    xmultiindex_range<N> multiindex_range(const std::array<I, N>& first, const std::array<I, N>& last) noexcept;
+
+    template <class I, std::size_t N>
+    xmultiindex_range<N> multiindex_range(const std::array<I, N>& shape) noexcept;
+
+    /************************************
+     * xmultiindex_range implementation *
+     ************************************/
+
+    template <std::size_t N>
+    inline xmultiindex_range<N>::xmultiindex_range(const index_type& first, const index_type& last) noexcept
+        : m_first(first)
+        , m_last(last)
+    {
+    }
+
+    template <std::size_t N>
+    inline auto xmultiindex_range<N>::first() const noexcept -> const index_type&
+    {
+        return m_first;
+    }
+
+    template <std::size_t N>
+    inline auto xmultiindex_range<N>::last() const noexcept -> const index_type&
+    {
+        return m_last;
+    }
+
+    template <std::size_t N>
+    inline auto xmultiindex_range<N>::size() const noexcept -> size_type
+    {
+        size_type res = 1;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            res *= m_last[i] > m_first[i] ? m_last[i] - m_first[i] : size_type(0);
+        }
+        return res;
+    }
+
+    template <std::size_t N>
+    inline bool xmultiindex_range<N>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template <std::size_t N>
+    inline auto xmultiindex_range<N>::begin() const -> iterator
+    {
+        return iterator(m_first, m_last, m_first, 0);
+    }
+
+    template <std::size_t N>
+    inline auto xmultiindex_range<N>::end() const -> iterator
+    {
+        return iterator(m_first, m_last, m_last, size());
+    }
+
+    /**
+     * Returns the part \a part of \a parts contiguous parts of the range,
+     * the first dimension being split as evenly as possible.
+     * \a parts must be positive and \a part smaller than \a parts.
+     */
+    template <std::size_t N>
+    inline auto xmultiindex_range<N>::split(size_type part, size_type parts) const -> self_type
+        requires(N > 0)
+    {
+        XTENSOR_ASSERT(parts > 0 && part < parts);
+        const size_type extent = m_last[0] > m_first[0] ? m_last[0] - m_first[0] : size_type(0);
+        self_type res = *this;
+        res.m_first[0] = m_first[0] + extent * part / parts;
+        res.m_last[0] = m_first[0] + extent * (part + 1) / parts;
+        return res;
+    }
+
+    /**
+     * Calls \a f with every index of the range, in row major order.
+     * @param f function taking a const reference to an index_type
+     */
+    template <std::size_t N>
+    template <class F>
+    inline void xmultiindex_range<N>::for_each(F&& f) const
+    {
+        if (!empty())
+        {
+            index_type index = m_first;
+            loop<0>(index, f);
+        }
+    }
+
+    /**
+     * Calls \a f with every index of the range, the first dimension being
+     * shared between threads when TBB or OpenMP is enabled and the range is
+     * large enough. \a f must be safe to call concurrently, the order of the
+     * calls is unspecified.
+     * @param f function taking a const reference to an index_type
+     */
+    template <std::size_t N>
+    template <class F>
+    inline void xmultiindex_range<N>::parallel_for_each(F&& f) const
+    {
+        if constexpr (N == 0)
+        {
+            for_each(f);
+        }
+        else if (!empty())
+        {
+            detail::parallel_chunks(
+                m_last[0] - m_first[0],
+                size(),
+                [this, &f](std::size_t begin, std::size_t end)
+                {
+                    self_type sub = *this;
+                    sub.m_first[0] = m_first[0] + begin;
+                    sub.m_last[0] = m_first[0] + end;
+                    sub.for_each(f);
+                }
+            );
+        }
+    }
+
+    template <std::size_t N>
+    template <std::size_t D, class F>
+    inline void xmultiindex_range<N>::loop(index_type& index, F& f) const
+    {
+        const index_type& cindex = index;
+        if constexpr (D == N)
+        {
+            f(cindex);
+        }
+        else if constexpr (D + 1 == N)
+        {
+            std::size_t& i = index[D];
+            const std::size_t last = m_last[D];
+            for (i = m_first[D]; i + 4 <= last;)
+            {
+                f(cindex);
+                ++i;
+                f(cindex);
+                ++i;
+                f(cindex);
+                ++i;
+                f(cindex);
+                ++i;
+            }
+            for (; i < last; ++i)
+            {
+                f(cindex);
+            }
+        }
+        else
+        {
+            for (index[D] = m_first[D]; index[D] < m_last[D]; ++index[D])
+            {
+                loop<D + 1>(index, f);
+            }
+        }
+    }
+
+    /**
+     * Builds the range of the indices of [first, last), the rank being
+     * deduced from the size of the arrays (e.g. the shape of an xtensor).
+     */
+    template <class I, std::size_t N>
+    inline xmultiindex_range<N>
+    multiindex_range(const std::array<I, N>& first, const std::array<I, N>& last) noexcept
+    {
+        std::array<std::size_t, N> f, l;
+        std::transform(
+            first.cbegin(),
+            first.cend(),
+            f.begin(),
+            [](I i)
+            {
+                return static_cast<std::size_t>(i);
+            }
+        );
+        std::transform(
+            last.cbegin(),
+            last.cend(),
+            l.begin(),
+            [](I i)
+            {
+                return static_cast<std::size_t>(i);
+            }
+        );
+        return xmultiindex_range<N>(f, l);
+    }
+
+    /**
+     * Builds the range of the indices of an expression of the given shape.
+     */
+    template <class I, std::size_t N>
+    inline xmultiindex_range<N> multiindex_range(const std::array<I, N>& shape) noexcept
+    {
+        return multiindex_range(std::array<I, N>{}, shape);
+    }
 }
 
 #endif
@@ -71,6 +71,10 @@
 #define XTENSOR_DEFAULT_ALLOCATOR(T) \
     xt::tracking_allocator<T, std::allocator<T>, XTENSOR_ALLOC_TRACKING_POLICY>
 #endif
+#elif defined(XTENSOR_USE_HUGE_PAGES)
+#define XTENSOR_DEFAULT_ALLOCATOR(T) xt::huge_page_allocator<T>
+#elif defined(XTENSOR_USE_STORAGE_POOL)
+#define XTENSOR_DEFAULT_ALLOCATOR(T) xt::pool_allocator<T>
 #else
 #ifdef XTENSOR_USE_XSIMD
 
@@ -129,4 +133,8 @@ namespace xtl
 }
 #endif
 
+#if defined(XTENSOR_USE_HUGE_PAGES) || defined(XTENSOR_USE_STORAGE_POOL)
+#include "../utils/xallocator.hpp"
+#endif
+
 #endif
@@ -47,6 +47,9 @@ namespace xt
     template <class T, std::size_t N, class A, bool Init>
     class svector;
 
+    template <class T, std::size_t N, class A>
+    class compact_vector;
+
     template <
         class EC,
         layout_type L = XTENSOR_DEFAULT_LAYOUT,
@@ -81,6 +84,25 @@ namespace xt
         class SA = std::allocator<typename std::vector<T, A>::size_type>>
     using xarray = xarray_container<XTENSOR_DEFAULT_DATA_CONTAINER(T, A), L, XTENSOR_DEFAULT_SHAPE_CONTAINER(T, A, SA)>;
 
+    /**
+     * @typedef xarray_compact
+     * Alias template on xarray_container whose shape, strides and backstrides
+     * are stored in compact_vector. Up to \c N dimensions are held inline
+     * without any allocation, and the footprint of the container is smaller
+     * than that of xarray for the same inline capacity. Use it when creating
+     * many small arrays of dynamic dimension.
+     *
+     * @tparam T The value type of the elements.
+     * @tparam N The number of dimensions stored inline (default: 8).
+     * @tparam L The layout_type of the xarray_container (default: XTENSOR_DEFAULT_LAYOUT).
+     * @tparam A The allocator of the container holding the elements.
+     */
+    template <class T, std::size_t N = 8, layout_type L = XTENSOR_DEFAULT_LAYOUT, class A = XTENSOR_DEFAULT_ALLOCATOR(T)>
+    using xarray_compact = xarray_container<
+        XTENSOR_DEFAULT_DATA_CONTAINER(T, A),
+        L,
+        compact_vector<typename XTENSOR_DEFAULT_DATA_CONTAINER(T, A)::size_type, N, std::allocator<typename XTENSOR_DEFAULT_DATA_CONTAINER(T, A)::size_type>>>;
+
     template <
         class EC,
         layout_type L = XTENSOR_DEFAULT_LAYOUT,
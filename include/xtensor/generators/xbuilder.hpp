@@ -14,11 +14,13 @@
 #ifndef XTENSOR_BUILDER_HPP
 #define XTENSOR_BUILDER_HPP
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <functional>
+#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -26,9 +28,11 @@
 #include <xtl/xsequence.hpp>
 #include <xtl/xtype_traits.hpp>
 
+#include "../core/xassign.hpp"
 #include "../core/xfunction.hpp"
 #include "../core/xoperation.hpp"
 #include "../generators/xgenerator.hpp"
+#include "../utils/xutils.hpp"
 #include "../views/xbroadcast.hpp"
 
 namespace xt
@@ -88,21 +92,21 @@ namespace xt
     template <class T, layout_type L = XTENSOR_DEFAULT_LAYOUT, class S>
     inline xarray<T, L> empty(const S& shape)
     {
-        return xarray<T, L>::from_shape(shape);
+        return xarray<T, L>::from_shape(shape, uninitialized);
     }
 
     template <class T, layout_type L = XTENSOR_DEFAULT_LAYOUT, class ST, std::size_t N>
     inline xtensor<T, N, L> empty(const std::array<ST, N>& shape)
     {
         using shape_type = typename xtensor<T, N>::shape_type;
-        return xtensor<T, N, L>(xtl::forward_sequence<shape_type, decltype(shape)>(shape));
+        return xtensor<T, N, L>(xtl::forward_sequence<shape_type, decltype(shape)>(shape), uninitialized);
     }
 
     template <class T, layout_type L = XTENSOR_DEFAULT_LAYOUT, class I, std::size_t N>
     inline xtensor<T, N, L> empty(const I (&shape)[N])
     {
         using shape_type = typename xtensor<T, N>::shape_type;
-        return xtensor<T, N, L>(xtl::forward_sequence<shape_type, decltype(shape)>(shape));
+        return xtensor<T, N, L>(xtl::forward_sequence<shape_type, decltype(shape)>(shape), uninitialized);
     }
 
     template <class T, layout_type L = XTENSOR_DEFAULT_LAYOUT, std::size_t... N>
@@ -121,7 +125,7 @@ namespace xt
     inline auto empty_like(const xexpression<E>& e)
     {
         using xtype = temporary_type_t<E>;
-        auto res = xtype::from_shape(e.derived_cast().shape());
+        auto res = uninitialized_from_shape<xtype>(e.derived_cast().shape());
         return res;
     }
 
@@ -136,7 +140,7 @@ namespace xt
     inline auto full_like(const xexpression<E>& e, typename E::value_type fill_value)
     {
         using xtype = temporary_type_t<E>;
-        auto res = xtype::from_shape(e.derived_cast().shape());
+        auto res = uninitialized_from_shape<xtype>(e.derived_cast().shape());
         res.fill(fill_value);
         return res;
     }
@@ -547,6 +551,13 @@ namespace xt
                 }
                 return apply<value_type>(i, get, t);
             }
+
+            // Extent of arr along axis in the result
+            template <class E>
+            static size_type extent(const E& arr, size_type axis)
+            {
+                return arr.shape()[axis];
+            }
         };
 
         template <class... CT>
@@ -588,6 +599,12 @@ namespace xt
                 size_type i = *(first + static_cast<std::ptrdiff_t>(axis));
                 return apply<value_type>(i, get_item, t);
             }
+
+            template <class E>
+            static size_type extent(const E&, size_type)
+            {
+                return size_type(1);
+            }
         };
 
         template <class... CT>
@@ -612,12 +629,91 @@ namespace xt
                 }
             }
 
+            template <class E>
+            static size_type extent(const E& arr, size_type axis)
+            {
+                return arr.dimension() == 1 ? size_type(1) : arr.shape()[axis];
+            }
+
         private:
 
             concatenate_access<CT...> concatonate;
             stack_access<CT...> stack;
         };
 
+        // Copies the operands of a concatenation into the row major buffer dst,
+        // made of outer slices holding one block of each operand after the other.
+        // The block of operand k has lengths[k] elements. Work units are pieces
+        // of long blocks or groups of short ones, so that the copies are shared
+        // between threads across operands and slices.
+        template <class U, class... E>
+        inline void concatenate_blocks(
+            U* dst,
+            std::size_t outer,
+            const std::array<std::size_t, sizeof...(E)>& lengths,
+            const std::tuple<contiguous_operand<E>...>& src
+        )
+        {
+            constexpr std::size_t n = sizeof...(E);
+            constexpr std::size_t piece = std::size_t(1) << 14;
+            std::array<std::size_t, n> offsets, pieces, rows;
+            std::array<std::size_t, n + 1> first_unit;
+            std::size_t slice = 0;
+            first_unit[0] = 0;
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                offsets[k] = slice;
+                slice += lengths[k];
+                pieces[k] = lengths[k] > piece ? (lengths[k] + piece - 1) / piece : std::size_t(1);
+                rows[k] = lengths[k] > piece ? std::size_t(1) : piece / std::max(lengths[k], std::size_t(1));
+                const std::size_t units = lengths[k] == 0 ? std::size_t(0)
+                                                          : (outer + rows[k] - 1) / rows[k] * pieces[k];
+                first_unit[k + 1] = first_unit[k] + units;
+            }
+            parallel_chunks(
+                first_unit[n],
+                outer * slice,
+                [&](std::size_t begin, std::size_t end)
+                {
+                    std::size_t k = 0;
+                    for (std::size_t u = begin; u < end; ++u)
+                    {
+                        while (u >= first_unit[k + 1])
+                        {
+                            ++k;
+                        }
+                        const std::size_t local = u - first_unit[k];
+                        const std::size_t first_row = local / pieces[k] * rows[k];
+                        const std::size_t last_row = std::min(first_row + rows[k], outer);
+                        const std::size_t first = local % pieces[k] * piece;
+                        const std::size_t count = std::min(piece, lengths[k] - first);
+                        apply<bool>(
+                            k,
+                            [&](const auto& op)
+                            {
+                                const std::size_t length = lengths[k];
+                                const auto* in = op.data() + first_row * length + first;
+                                U* out = dst + first_row * slice + offsets[k] + first;
+                                for (std::size_t o = first_row; o < last_row; ++o, in += length, out += slice)
+                                {
+                                    if (count == 1)
+                                    {
+                                        *out = static_cast<U>(*in);
+                                    }
+                                    else
+                                    {
+                                        std::copy(in, in + count, out);
+                                    }
+                                }
+                                return true;
+                            },
+                            src
+                        );
+                    }
+                }
+            );
+        }
+
         template <template <class...> class F, class... CT>
         class concatenate_invoker
         {
@@ -647,8 +743,41 @@ namespace xt
                 return access_method.access(m_t, m_axis, first, last);
             }
 
+            /**
+             * Copies the operands into \a e, already resized by the generator,
+             * as contiguous slabs instead of evaluating the elements one by one.
+             */
+            template <class E>
+                requires(has_block_storage<E>::value
+                         && (E::static_layout == layout_type::row_major
+                             || E::static_layout == layout_type::column_major))
+            inline void assign_to(xexpression<E>& e) const
+            {
+                auto& de = e.derived_cast();
+                if (de.size() != 0)
+                {
+                    assign_blocks(de, std::index_sequence_for<CT...>{});
+                }
+            }
+
         private:
 
+            template <class E, std::size_t... I>
+            inline void assign_blocks(E& de, std::index_sequence<I...>) const
+            {
+                const layout_type l = de.layout();
+                const block_layout b(de.shape(), l);
+                const std::size_t d = b.axis(m_axis);
+                const std::size_t inner = b.size[d + 1];
+                const std::array<std::size_t, sizeof...(CT)> lengths = {
+                    static_cast<std::size_t>(F<CT...>::extent(std::get<I>(m_t), m_axis)) * inner...
+                };
+                const std::tuple<contiguous_operand<std::decay_t<CT>>...> src(
+                    contiguous_operand<std::decay_t<CT>>(std::get<I>(m_t), l)...
+                );
+                concatenate_blocks(de.data(), b.outer(d), lengths, src);
+            }
+
             F<CT...> access_method;
             tuple_type m_t;
             size_type m_axis;
@@ -816,7 +945,9 @@ namespace xt
      *
      * @param t \ref xtuple of xexpressions to concatenate
      * @param axis axis along which elements are concatenated
-     * @returns xgenerator evaluating to concatenated elements
+     * @returns xgenerator evaluating to concatenated elements. Assigning it to
+     * a row major or column major container copies the operands as contiguous
+     * slabs, as for \ref stack, \ref hstack and \ref vstack.
      *
      * @code{.cpp}
      * xt::xarray<double> a = {{1, 2, 3}};
@@ -0,0 +1,598 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay and Wolf Vollprecht          *
+ * Copyright (c) QuantStack                                                 *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+/**
+ * @brief N-dimensional convolution and correlation
+ */
+
+#ifndef XTENSOR_CONVOLVE_HPP
+#define XTENSOR_CONVOLVE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../containers/xarray.hpp"
+#include "../containers/xtensor.hpp"
+#include "../core/xexpression_traits.hpp"
+#include "../misc/xpad.hpp"
+#include "../utils/xutils.hpp"
+
+namespace xt
+{
+    template <class E, class K, class V = typename std::decay_t<E>::value_type>
+    auto correlate_nd(E&& e, K&& kernel, pad_mode mode = pad_mode::constant, V constant_value = 0);
+
+    template <class E, class K, class V = typename std::decay_t<E>::value_type>
+    auto convolve_nd(E&& e, K&& kernel, pad_mode mode = pad_mode::constant, V constant_value = 0);
+
+    template <class E, class K, class V = typename std::decay_t<E>::value_type>
+    auto convolve_separable(
+        E&& e,
+        const std::vector<K>& kernels,
+        pad_mode mode = pad_mode::constant,
+        V constant_value = 0
+    );
+
+    /******************************
+     * xconvolve implementation *
+     ******************************/
+
+    namespace detail
+    {
+        // Number of output values of a row accumulated together, so that the
+        // accumulator stays in the L1 cache while all kernel taps are applied.
+        constexpr std::size_t convolve_tile = 512;
+
+        using convolve_shape = std::vector<std::size_t>;
+
+        inline std::size_t convolve_size(const convolve_shape& shape, std::size_t first, std::size_t last)
+        {
+            std::size_t res = 1;
+            for (std::size_t d = first; d < last; ++d)
+            {
+                res *= shape[d];
+            }
+            return res;
+        }
+
+        /**
+         * Index of the sample read at position i of an axis of length n when
+         * the axis is padded with mode, -1 when the constant value is read.
+         */
+        inline std::ptrdiff_t boundary_index(std::ptrdiff_t i, std::ptrdiff_t n, pad_mode mode)
+        {
+            if (i >= 0 && i < n)
+            {
+                return i;
+            }
+            auto positive_mod = [](std::ptrdiff_t a, std::ptrdiff_t b)
+            {
+                const std::ptrdiff_t r = a % b;
+                return r < 0 ? r + b : r;
+            };
+            switch (mode)
+            {
+                case pad_mode::constant:
+                    return -1;
+                case pad_mode::edge:
+                    return i < 0 ? 0 : n - 1;
+                case pad_mode::wrap:
+                case pad_mode::periodic:
+                    return positive_mod(i, n);
+                case pad_mode::symmetric:
+                {
+                    const std::ptrdiff_t r = positive_mod(i, 2 * n);
+                    return r < n ? r : 2 * n - 1 - r;
+                }
+                case pad_mode::reflect:
+                {
+                    if (n == 1)
+                    {
+                        return 0;
+                    }
+                    const std::ptrdiff_t r = positive_mod(i, 2 * n - 2);
+                    return r < n ? r : 2 * n - 2 - r;
+                }
+            }
+            return -1;
+        }
+
+        // Pads the row-major array in of the given shape along axis, shape is
+        // updated to the shape of the result.
+        template <class T>
+        inline std::vector<T> convolve_pad_axis(
+            const T* in,
+            convolve_shape& shape,
+            std::size_t axis,
+            std::size_t before,
+            std::size_t after,
+            pad_mode mode,
+            T constant_value
+        )
+        {
+            const std::size_t n = shape[axis];
+            const std::size_t np = n + before + after;
+            const std::size_t inner = convolve_size(shape, axis + 1, shape.size());
+            const std::size_t outer = convolve_size(shape, 0, axis);
+            std::vector<T> out(outer * np * inner);
+            for (std::size_t o = 0; o < outer; ++o)
+            {
+                for (std::size_t p = 0; p < np; ++p)
+                {
+                    const std::ptrdiff_t src = boundary_index(
+                        static_cast<std::ptrdiff_t>(p) - static_cast<std::ptrdiff_t>(before),
+                        static_cast<std::ptrdiff_t>(n),
+                        mode
+                    );
+                    auto dst = out.begin() + static_cast<std::ptrdiff_t>((o * np + p) * inner);
+                    if (src < 0)
+                    {
+                        std::fill(dst, dst + static_cast<std::ptrdiff_t>(inner), constant_value);
+                    }
+                    else
+                    {
+                        const T* first = in + (o * n + static_cast<std::size_t>(src)) * inner;
+                        std::copy(first, first + inner, dst);
+                    }
+                }
+            }
+            shape[axis] = np;
+            return out;
+        }
+
+        // dst[x] += w * src[x], x in [0, count)
+        template <class T>
+        inline void convolve_axpy(T* dst, const T* src, T w, std::size_t count)
+        {
+            for (std::size_t x = 0; x < count; ++x)
+            {
+                dst[x] += w * src[x];
+            }
+        }
+
+        // 1-D valid correlation of the padded row-major array p with f along
+        // axis, written to out whose length along axis is shrunk by k - 1.
+        template <class T>
+        inline void convolve_correlate_axis(
+            const T* p,
+            const convolve_shape& pshape,
+            std::size_t axis,
+            const T* f,
+            std::size_t k,
+            T* out
+        )
+        {
+            const std::size_t np = pshape[axis];
+            const std::size_t n = np - k + 1;
+            const std::size_t inner = convolve_size(pshape, axis + 1, pshape.size());
+            const std::size_t outer = convolve_size(pshape, 0, axis);
+            if (inner == 1)
+            {
+                // Contiguous rows, tiled along the row
+                parallel_chunks(
+                    outer,
+                    [=](std::size_t begin, std::size_t end)
+                    {
+                        for (std::size_t o = begin; o < end; ++o)
+                        {
+                            const T* prow = p + o * np;
+                            T* orow = out + o * n;
+                            for (std::size_t x0 = 0; x0 < n; x0 += convolve_tile)
+                            {
+                                const std::size_t count = std::min(convolve_tile, n - x0);
+                                std::fill(orow + x0, orow + x0 + count, T(0));
+                                for (std::size_t j = 0; j < k; ++j)
+                                {
+                                    convolve_axpy(orow + x0, prow + x0 + j, f[j], count);
+                                }
+                            }
+                        }
+                    }
+                );
+            }
+            else
+            {
+                // Every output row is a combination of k contiguous input rows
+                parallel_chunks(
+                    outer * n,
+                    [=](std::size_t begin, std::size_t end)
+                    {
+                        for (std::size_t t = begin; t < end; ++t)
+                        {
+                            const std::size_t o = t / n;
+                            const std::size_t i = t % n;
+                            T* orow = out + t * inner;
+                            std::fill(orow, orow + inner, T(0));
+                            for (std::size_t j = 0; j < k; ++j)
+                            {
+                                convolve_axpy(orow, p + (o * np + i + j) * inner, f[j], inner);
+                            }
+                        }
+                    }
+                );
+            }
+        }
+
+        // N-d valid correlation of the padded row-major array p with the kernel
+        // k, parallelized over the output rows and tiled along them.
+        template <class T>
+        inline void convolve_correlate_valid(
+            const T* p,
+            const convolve_shape& pshape,
+            const T* k,
+            const convolve_shape& kshape,
+            T* out,
+            const convolve_shape& oshape
+        )
+        {
+            const std::size_t dim = oshape.size();
+            const std::size_t n = oshape[dim - 1];
+            const std::size_t klast = kshape[dim - 1];
+            const std::size_t rows = convolve_size(oshape, 0, dim - 1);
+            const std::size_t krows = convolve_size(kshape, 0, dim - 1);
+
+            convolve_shape pstrides(dim);
+            pstrides[dim - 1] = 1;
+            for (std::size_t d = dim - 1; d > 0; --d)
+            {
+                pstrides[d - 1] = pstrides[d] * pshape[d];
+            }
+
+            // offset in p of the first value of every kernel row
+            std::vector<std::size_t> koffsets(krows);
+            for (std::size_t r = 0; r < krows; ++r)
+            {
+                std::size_t rem = r;
+                std::size_t offset = 0;
+                for (std::size_t d = dim - 1; d > 0; --d)
+                {
+                    offset += (rem % kshape[d - 1]) * pstrides[d - 1];
+                    rem /= kshape[d - 1];
+                }
+                koffsets[r] = offset;
+            }
+
+            parallel_chunks(
+                rows,
+                [&, n, klast, krows, dim](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t row = begin; row < end; ++row)
+                    {
+                        std::size_t rem = row;
+                        std::size_t base = 0;
+                        for (std::size_t d = dim - 1; d > 0; --d)
+                        {
+                            base += (rem % oshape[d - 1]) * pstrides[d - 1];
+                            rem /= oshape[d - 1];
+                        }
+                        T* orow = out + row * n;
+                        for (std::size_t x0 = 0; x0 < n; x0 += convolve_tile)
+                        {
+                            const std::size_t count = std::min(convolve_tile, n - x0);
+                            std::fill(orow + x0, orow + x0 + count, T(0));
+                            for (std::size_t r = 0; r < krows; ++r)
+                            {
+                                const T* prow = p + base + koffsets[r] + x0;
+                                const T* krow = k + r * klast;
+                                for (std::size_t j = 0; j < klast; ++j)
+                                {
+                                    if (krow[j] != T(0))
+                                    {
+                                        convolve_axpy(orow + x0, prow + j, krow[j], count);
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            );
+        }
+
+        template <class T>
+        struct is_separable_candidate : std::is_floating_point<T>
+        {
+        };
+
+        template <class T>
+        struct is_separable_candidate<std::complex<T>> : std::is_floating_point<T>
+        {
+        };
+
+        /**
+         * Factors a rank-1 kernel into one 1-D kernel per axis, returns an empty
+         * vector when the kernel is not the outer product of 1-D kernels.
+         */
+        template <class T>
+        inline std::vector<std::vector<T>> separate_kernel(const T* k, const convolve_shape& kshape)
+        {
+            std::vector<std::vector<T>> factors;
+            const std::size_t dim = kshape.size();
+            if constexpr (is_separable_candidate<T>::value)
+            {
+                using real_type = decltype(std::abs(std::declval<T>()));
+                const std::size_t size = convolve_size(kshape, 0, dim);
+                if (dim < 2 || size == 0)
+                {
+                    return factors;
+                }
+                auto pivot_it = std::max_element(
+                    k,
+                    k + size,
+                    [](const T& a, const T& b)
+                    {
+                        return std::abs(a) < std::abs(b);
+                    }
+                );
+                const T pivot = *pivot_it;
+                const real_type max_abs = std::abs(pivot);
+                if (max_abs == real_type(0))
+                {
+                    return factors;
+                }
+
+                convolve_shape strides(dim);
+                strides[dim - 1] = 1;
+                for (std::size_t d = dim - 1; d > 0; --d)
+                {
+                    strides[d - 1] = strides[d] * kshape[d];
+                }
+                const std::size_t pivot_index = static_cast<std::size_t>(pivot_it - k);
+
+                // The factor of axis d is the line of the kernel through the pivot,
+                // the first one is divided by pivot^(dim - 1).
+                factors.resize(dim);
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    const std::size_t pivot_coord = (pivot_index / strides[d]) % kshape[d];
+                    const std::size_t line = pivot_index - pivot_coord * strides[d];
+                    factors[d].resize(kshape[d]);
+                    for (std::size_t i = 0; i < kshape[d]; ++i)
+                    {
+                        factors[d][i] = k[line + i * strides[d]];
+                    }
+                }
+                T scale = T(1);
+                for (std::size_t d = 1; d < dim; ++d)
+                {
+                    scale *= pivot;
+                }
+                for (auto& v : factors[0])
+                {
+                    v /= scale;
+                }
+
+                const real_type tolerance = real_type(16) * real_type(dim)
+                                            * std::numeric_limits<real_type>::epsilon() * max_abs;
+                for (std::size_t index = 0; index < size; ++index)
+                {
+                    T product = T(1);
+                    for (std::size_t d = 0; d < dim; ++d)
+                    {
+                        product *= factors[d][(index / strides[d]) % kshape[d]];
+                    }
+                    if (std::abs(product - k[index]) > tolerance)
+                    {
+                        factors.clear();
+                        return factors;
+                    }
+                }
+            }
+            return factors;
+        }
+
+        template <class E, class T>
+        using convolve_result_t = typename xtype_for_shape<
+            typename std::decay_t<E>::shape_type>::template type<T, layout_type::row_major>;
+
+        /**
+         * In place correlation of the row-major array data with one 1-D kernel
+         * per axis, centers[d] being the index of the kernel tap aligned with
+         * the output sample. With pad_mode::constant, the padding value of every
+         * pass is scaled by the sum of the kernels of the previous passes.
+         */
+        template <class T>
+        inline void correlate_separable_impl(
+            T* data,
+            convolve_shape shape,
+            const std::vector<std::vector<T>>& factors,
+            const convolve_shape& centers,
+            pad_mode mode,
+            T constant_value
+        )
+        {
+            for (std::size_t d = 0; d < shape.size(); ++d)
+            {
+                const std::size_t k = factors[d].size();
+                const std::size_t n = shape[d];
+                convolve_shape pshape = shape;
+                auto padded = convolve_pad_axis(data, pshape, d, centers[d], k - 1 - centers[d], mode, constant_value);
+                convolve_correlate_axis(padded.data(), pshape, d, factors[d].data(), k, data);
+                shape[d] = n;
+                T sum = T(0);
+                for (const auto& v : factors[d])
+                {
+                    sum += v;
+                }
+                constant_value *= sum;
+            }
+        }
+
+        // In place N-d correlation of the row-major array data with the kernel k.
+        template <class T>
+        inline void correlate_nd_impl(
+            T* data,
+            const convolve_shape& shape,
+            const T* k,
+            const convolve_shape& kshape,
+            const convolve_shape& centers,
+            pad_mode mode,
+            T constant_value
+        )
+        {
+            auto factors = separate_kernel(k, kshape);
+            if (!factors.empty())
+            {
+                correlate_separable_impl(data, shape, factors, centers, mode, constant_value);
+                return;
+            }
+
+            convolve_shape pshape = shape;
+            std::vector<T> padded = convolve_pad_axis(data, pshape, 0, centers[0], kshape[0] - 1 - centers[0], mode, constant_value);
+            for (std::size_t d = 1; d < shape.size(); ++d)
+            {
+                padded = convolve_pad_axis(
+                    padded.data(),
+                    pshape,
+                    d,
+                    centers[d],
+                    kshape[d] - 1 - centers[d],
+                    mode,
+                    constant_value
+                );
+            }
+            convolve_correlate_valid(padded.data(), pshape, k, kshape, data, shape);
+        }
+
+        template <bool Convolve, class E, class K, class V>
+        inline auto correlate_nd_dispatch(E&& e, K&& kernel, pad_mode mode, V constant_value)
+        {
+            using value_type = std::common_type_t<
+                typename std::decay_t<E>::value_type,
+                typename std::decay_t<K>::value_type>;
+            using result_type = convolve_result_t<E, value_type>;
+
+            if (e.dimension() != kernel.dimension())
+            {
+                XTENSOR_THROW(std::runtime_error, "Convolution kernel must have the dimension of the expression");
+            }
+            const convolve_shape shape(e.shape().cbegin(), e.shape().cend());
+            const convolve_shape kshape(kernel.shape().cbegin(), kernel.shape().cend());
+            if (shape.empty() || std::find(kshape.cbegin(), kshape.cend(), std::size_t(0)) != kshape.cend())
+            {
+                XTENSOR_THROW(std::runtime_error, "Convolution requires a non empty kernel of dimension > 0");
+            }
+
+            // The input is evaluated (or moved) into the result, which is then
+            // overwritten in place once its values have been padded.
+            result_type res = std::forward<E>(e);
+            if (res.size() == 0)
+            {
+                return res;
+            }
+            xarray<value_type, layout_type::row_major> k = std::forward<K>(kernel);
+
+            // A convolution is a correlation with the kernel flipped along every
+            // axis, i.e. with its row-major buffer reversed.
+            convolve_shape centers(kshape.size());
+            for (std::size_t d = 0; d < kshape.size(); ++d)
+            {
+                centers[d] = Convolve ? kshape[d] - 1 - kshape[d] / 2 : kshape[d] / 2;
+            }
+            if (Convolve)
+            {
+                std::reverse(k.data(), k.data() + k.size());
+            }
+            correlate_nd_impl(res.data(), shape, k.data(), kshape, centers, mode, static_cast<value_type>(constant_value));
+            return res;
+        }
+    }
+
+    /**
+     * @brief N-dimensional correlation.
+     *
+     * Computes ``out[i] = sum_j kernel[j] * e[i + j - kernel.shape() / 2]`` where
+     * the samples of \c e out of bounds are given by \c mode, as in ``xt::pad``.
+     * The result has the shape of \c e. When the kernel is the outer product
+     * of 1-D kernels (rank 1), one 1-D correlation per axis is computed instead.
+     *
+     * @param e the expression to correlate
+     * @param kernel the kernel, of the same dimension as \c e
+     * @param mode the boundary mode [default: `xt::pad_mode::constant`]
+     * @param constant_value the value of the samples out of bounds with `xt::pad_mode::constant`
+     * @return an array with the shape of \c e and the common value type of \c e and \c kernel
+     */
+    template <class E, class K, class V>
+    inline auto correlate_nd(E&& e, K&& kernel, pad_mode mode, V constant_value)
+    {
+        return detail::correlate_nd_dispatch<false>(std::forward<E>(e), std::forward<K>(kernel), mode, constant_value);
+    }
+
+    /**
+     * @brief N-dimensional convolution.
+     *
+     * Correlation with the kernel flipped along every axis; for even kernel
+     * lengths the origin is shifted so that the result matches
+     * ``scipy.ndimage.convolve``.
+     *
+     * @param e the expression to convolve
+     * @param kernel the kernel, of the same dimension as \c e
+     * @param mode the boundary mode [default: `xt::pad_mode::constant`]
+     * @param constant_value the value of the samples out of bounds with `xt::pad_mode::constant`
+     * @return an array with the shape of \c e and the common value type of \c e and \c kernel
+     * @sa correlate_nd
+     */
+    template <class E, class K, class V>
+    inline auto convolve_nd(E&& e, K&& kernel, pad_mode mode, V constant_value)
+    {
+        return detail::correlate_nd_dispatch<true>(std::forward<E>(e), std::forward<K>(kernel), mode, constant_value);
+    }
+
+    /**
+     * @brief N-dimensional convolution with a separable kernel.
+     *
+     * Equivalent to convolve_nd with the outer product of \c kernels, computed
+     * as one 1-D convolution per axis.
+     *
+     * @param e the expression to convolve
+     * @param kernels one 1-D kernel per axis of \c e
+     * @param mode the boundary mode [default: `xt::pad_mode::constant`]
+     * @param constant_value the value of the samples out of bounds with `xt::pad_mode::constant`
+     * @return an array with the shape of \c e
+     */
+    template <class E, class K, class V>
+    inline auto convolve_separable(E&& e, const std::vector<K>& kernels, pad_mode mode, V constant_value)
+    {
+        using value_type = std::common_type_t<typename std::decay_t<E>::value_type, typename K::value_type>;
+        using result_type = detail::convolve_result_t<E, value_type>;
+
+        const detail::convolve_shape shape(e.shape().cbegin(), e.shape().cend());
+        if (kernels.size() != shape.size())
+        {
+            XTENSOR_THROW(std::runtime_error, "convolve_separable requires one kernel per axis");
+        }
+        std::vector<std::vector<value_type>> factors(kernels.size());
+        detail::convolve_shape centers(kernels.size());
+        for (std::size_t d = 0; d < kernels.size(); ++d)
+        {
+            if (kernels[d].dimension() != 1 || kernels[d].size() == 0)
+            {
+                XTENSOR_THROW(std::runtime_error, "convolve_separable requires non empty 1-D kernels");
+            }
+            factors[d].assign(kernels[d].cbegin(), kernels[d].cend());
+            std::reverse(factors[d].begin(), factors[d].end());
+            centers[d] = factors[d].size() - 1 - factors[d].size() / 2;
+        }
+
+        result_type res = std::forward<E>(e);
+        if (res.size() == 0)
+        {
+            return res;
+        }
+        detail::correlate_separable_impl(res.data(), shape, factors, centers, mode, static_cast<value_type>(constant_value));
+        return res;
+    }
+}
+
+#endif
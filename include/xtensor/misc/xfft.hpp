@@ -1,7 +1,22 @@
-#ifdef XTENSOR_USE_TBB
-#include <oneapi/tbb.h>
-#endif
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay and Wolf Vollprecht          *
+ * Copyright (c) QuantStack                                                 *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XTENSOR_FFT_HPP
+#define XTENSOR_FFT_HPP
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <numeric>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include <xtl/xcomplex.hpp>
 
@@ -12,6 +27,7 @@
 #include "../misc/xcomplex.hpp"
 #include "../views/xaxis_slice_iterator.hpp"
 #include "../views/xview.hpp"
+#include "./xfft_plan.hpp"
 #include "./xtl_concepts.hpp"
 
 namespace xt
@@ -20,106 +36,216 @@ namespace xt
     {
         namespace detail
         {
-            template <xtl::complex_concept E>
-            inline auto radix2(E&& e)
+            // Number of lanes gathered together when the transformed axis is not the
+            // last one: each row of the block is then read and written contiguously.
+            constexpr std::size_t fft_lane_block = 16;
+
+            // Calls f on every 1-D lane of the row-major array a along axis. The
+            // lane is passed as a pointer to its contiguous values, lanes that are
+            // not contiguous in a are transformed through a buffer, by blocks of
+            // fft_lane_block neighbouring lanes. Lanes are processed in parallel.
+            template <class T, class F>
+            inline void for_each_lane(xt::xarray<T, layout_type::row_major>& a, std::size_t axis, F&& f)
             {
-                using namespace xt::placeholders;
-                using namespace std::complex_literals;
-                using value_type = typename std::decay_t<E>::value_type;
-                using precision = typename value_type::value_type;
-                auto N = e.size();
-                const bool powerOfTwo = !(N == 0) && !(N & (N - 1));
-                // check for power of 2
-                if (!powerOfTwo || N == 0)
+                const std::size_t n = a.shape(axis);
+                if (n == 0 || a.size() == 0)
                 {
-                    // TODO: Replace implementation with dft
-                    XTENSOR_THROW(std::runtime_error, "FFT Implementation requires power of 2");
+                    return;
                 }
-                auto pi = xt::numeric_constants<precision>::PI;
-                xt::xtensor<value_type, 1> ev = e;
-                if (N <= 1)
+                std::size_t inner = 1;
+                for (std::size_t d = axis + 1; d < a.dimension(); ++d)
                 {
-                    return ev;
+                    inner *= a.shape(d);
                 }
-                else
+                const std::size_t outer = a.size() / (n * inner);
+                T* data = a.data();
+                if (inner == 1)
                 {
-#ifdef XTENSOR_USE_TBB
-                    xt::xtensor<value_type, 1> even;
-                    xt::xtensor<value_type, 1> odd;
-                    oneapi::tbb::parallel_invoke(
-                        [&]
-                        {
-                            even = radix2(xt::view(ev, xt::range(0, _, 2)));
-                        },
-                        [&]
+                    xt::detail::parallel_chunks(
+                        outer,
+                        a.size(),
+                        [data, n, &f](std::size_t begin, std::size_t end)
                         {
-                            odd = radix2(xt::view(ev, xt::range(1, _, 2)));
+                            for (std::size_t o = begin; o < end; ++o)
+                            {
+                                f(data + o * n);
+                            }
                         }
                     );
-#else
-                    auto even = radix2(xt::view(ev, xt::range(0, _, 2)));
-                    auto odd = radix2(xt::view(ev, xt::range(1, _, 2)));
-#endif
-
-                    auto range = xt::arange<double>(N / 2);
-                    auto exp = xt::exp(static_cast<value_type>(-2i) * pi * range / N);
-                    auto t = exp * odd;
-                    auto first_half = even + t;
-                    auto second_half = even - t;
-                    // TODO: should be a call to stack if performance was improved
-                    auto spectrum = xt::xtensor<value_type, 1>::from_shape({N});
-                    xt::view(spectrum, xt::range(0, N / 2)) = first_half;
-                    xt::view(spectrum, xt::range(N / 2, N)) = second_half;
-                    return spectrum;
+                    return;
                 }
+
+                const std::size_t blocks = (inner + fft_lane_block - 1) / fft_lane_block;
+                xt::detail::parallel_chunks(
+                    outer * blocks,
+                    a.size(),
+                    [data, n, inner, blocks, &f](std::size_t begin, std::size_t end)
+                    {
+                        std::vector<T> buffer(n * fft_lane_block);
+                        for (std::size_t t = begin; t < end; ++t)
+                        {
+                            const std::size_t first = (t % blocks) * fft_lane_block;
+                            const std::size_t count = std::min(fft_lane_block, inner - first);
+                            T* base = data + (t / blocks) * n * inner + first;
+                            for (std::size_t k = 0; k < n; ++k)
+                            {
+                                const T* row = base + k * inner;
+                                for (std::size_t l = 0; l < count; ++l)
+                                {
+                                    buffer[l * n + k] = row[l];
+                                }
+                            }
+                            for (std::size_t l = 0; l < count; ++l)
+                            {
+                                f(buffer.data() + l * n);
+                            }
+                            for (std::size_t k = 0; k < n; ++k)
+                            {
+                                T* row = base + k * inner;
+                                for (std::size_t l = 0; l < count; ++l)
+                                {
+                                    row[l] = buffer[l * n + k];
+                                }
+                            }
+                        }
+                    }
+                );
             }
 
-            template <typename E>
-            auto transform_bluestein(E&& data)
+            // Calls f(in_lane, out_lane) on every pair of 1-D lanes along axis of
+            // the row-major arrays in and out, whose shapes only differ along axis.
+            // Lanes are blocked and processed in parallel like in for_each_lane.
+            template <class I, class O, class F>
+            inline void transform_lanes(
+                const xt::xarray<I, layout_type::row_major>& in,
+                xt::xarray<O, layout_type::row_major>& out,
+                std::size_t axis,
+                F&& f
+            )
             {
-                using value_type = typename std::decay_t<E>::value_type;
-                using precision = typename value_type::value_type;
-
-                // Find a power-of-2 convolution length m such that m >= n * 2 + 1
-                const std::size_t n = data.size();
-                size_t m = std::ceil(std::log2(n * 2 + 1));
-                m = std::pow(2, m);
-
-                // Trignometric table
-                auto exp_table = xt::xtensor<std::complex<precision>, 1>::from_shape({n});
-                xt::xtensor<std::size_t, 1> i = xt::pow(xt::linspace<std::size_t>(0, n - 1, n), 2);
-                i %= (n * 2);
-
-                auto angles = xt::eval(precision{3.141592653589793238463} * i / n);
-                auto j = std::complex<precision>(0, 1);
-                exp_table = xt::exp(-angles * j);
-
-                // Temporary vectors and preprocessing
-                auto av = xt::empty<std::complex<precision>>({m});
-                xt::view(av, xt::range(0, n)) = data * exp_table;
-
+                const std::size_t n_in = in.shape(axis);
+                const std::size_t n_out = out.shape(axis);
+                if (n_in == 0 || n_out == 0 || out.size() == 0)
+                {
+                    return;
+                }
+                std::size_t inner = 1;
+                for (std::size_t d = axis + 1; d < out.dimension(); ++d)
+                {
+                    inner *= out.shape(d);
+                }
+                const std::size_t outer = out.size() / (n_out * inner);
+                const I* in_data = in.data();
+                O* out_data = out.data();
+                if (inner == 1)
+                {
+                    xt::detail::parallel_chunks(
+                        outer,
+                        in.size() + out.size(),
+                        [in_data, out_data, n_in, n_out, &f](std::size_t begin, std::size_t end)
+                        {
+                            for (std::size_t o = begin; o < end; ++o)
+                            {
+                                f(in_data + o * n_in, out_data + o * n_out);
+                            }
+                        }
+                    );
+                    return;
+                }
 
-                auto bv = xt::empty<std::complex<precision>>({m});
-                xt::view(bv, xt::range(0, n)) = ::xt::conj(exp_table);
-                xt::view(bv, xt::range(-n + 1, xt::placeholders::_)) = xt::view(
-                    ::xt::conj(xt::flip(exp_table)),
-                    xt::range(xt::placeholders::_, -1)
+                const std::size_t blocks = (inner + fft_lane_block - 1) / fft_lane_block;
+                xt::detail::parallel_chunks(
+                    outer * blocks,
+                    in.size() + out.size(),
+                    [in_data, out_data, n_in, n_out, inner, blocks, &f](std::size_t begin, std::size_t end)
+                    {
+                        std::vector<I> in_buffer(n_in * fft_lane_block);
+                        std::vector<O> out_buffer(n_out * fft_lane_block);
+                        for (std::size_t t = begin; t < end; ++t)
+                        {
+                            const std::size_t first = (t % blocks) * fft_lane_block;
+                            const std::size_t count = std::min(fft_lane_block, inner - first);
+                            const I* in_base = in_data + (t / blocks) * n_in * inner + first;
+                            O* out_base = out_data + (t / blocks) * n_out * inner + first;
+                            for (std::size_t k = 0; k < n_in; ++k)
+                            {
+                                const I* row = in_base + k * inner;
+                                for (std::size_t l = 0; l < count; ++l)
+                                {
+                                    in_buffer[l * n_in + k] = row[l];
+                                }
+                            }
+                            for (std::size_t l = 0; l < count; ++l)
+                            {
+                                f(in_buffer.data() + l * n_in, out_buffer.data() + l * n_out);
+                            }
+                            for (std::size_t k = 0; k < n_out; ++k)
+                            {
+                                O* row = out_base + k * inner;
+                                for (std::size_t l = 0; l < count; ++l)
+                                {
+                                    row[l] = out_buffer[l * n_out + k];
+                                }
+                            }
+                        }
+                    }
                 );
+            }
 
-                // Convolution
-                auto xv = radix2(av);
-                auto yv = radix2(bv);
-                auto spectrum_k = xv * yv;
-                auto complex_args = xt::conj(spectrum_k);
-                auto fft_res = radix2(complex_args);
-                auto cv = xt::conj(fft_res) / m;
+            template <bool Inverse, class E>
+            inline auto fft_impl(E&& e, std::ptrdiff_t axis)
+            {
+                using value_type = typename std::decay_t<E>::value_type;
+                using precision = typename value_type::value_type;
+                const auto saxis = xt::normalize_axis(e.dimension(), axis);
+                const std::size_t N = e.shape(saxis);
+                xt::xarray<std::complex<precision>, layout_type::row_major> out = xt::eval(e);
+                if (N > 1)
+                {
+                    auto plan = get_plan<precision>(N);
+                    for_each_lane(
+                        out,
+                        saxis,
+                        [&plan](std::complex<precision>* lane)
+                        {
+                            Inverse ? plan->backward(lane) : plan->forward(lane);
+                        }
+                    );
+                }
+                return out;
+            }
 
-                return xt::eval(xt::view(cv, xt::range(0, n)) * exp_table);
+            template <bool Inverse, class E, class X>
+            inline auto fftn_impl(E&& e, const X& axes)
+            {
+                using value_type = typename std::decay_t<E>::value_type;
+                using precision = typename value_type::value_type;
+                xt::xarray<std::complex<precision>, layout_type::row_major> out = xt::eval(e);
+                for (auto axis : axes)
+                {
+                    const auto saxis = xt::normalize_axis(out.dimension(), static_cast<std::ptrdiff_t>(axis));
+                    const std::size_t N = out.shape(saxis);
+                    if (N > 1)
+                    {
+                        auto plan = get_plan<precision>(N);
+                        for_each_lane(
+                            out,
+                            saxis,
+                            [&plan](std::complex<precision>* lane)
+                            {
+                                Inverse ? plan->backward(lane) : plan->forward(lane);
+                            }
+                        );
+                    }
+                }
+                return out;
             }
         }  // namespace detail
 
         /**
          * @brief 1D FFT of an Nd array along a specified axis
+         *
+         * Every lane is transformed in place with the cached fft_plan of its length.
          * @param e an Nd expression to be transformed to the fourier domain
          * @param axis the axis along which to perform the 1D FFT
          * @return a transformed xarray of the specified precision
@@ -130,25 +256,7 @@ namespace xt
             using value_type = typename std::decay<E>::type::value_type;
             if constexpr (xtl::is_complex<typename std::decay<E>::type::value_type>::value)
             {
-                using precision = typename value_type::value_type;
-                const auto saxis = xt::normalize_axis(e.dimension(), axis);
-                const size_t N = e.shape(saxis);
-                const bool powerOfTwo = !(N == 0) && !(N & (N - 1));
-                xt::xarray<std::complex<precision>> out = xt::eval(e);
-                auto begin = xt::axis_slice_begin(out, saxis);
-                auto end = xt::axis_slice_end(out, saxis);
-                for (auto iter = begin; iter != end; iter++)
-                {
-                    if (powerOfTwo)
-                    {
-                        xt::noalias(*iter) = detail::radix2(*iter);
-                    }
-                    else
-                    {
-                        xt::noalias(*iter) = detail::transform_bluestein(*iter);
-                    }
-                }
-                return out;
+                return detail::fft_impl<false>(std::forward<E>(e), axis);
             }
             else
             {
@@ -156,21 +264,21 @@ namespace xt
             }
         }
 
+        /**
+         * @brief unnormalized 1D inverse FFT of an Nd array along a specified axis
+         */
         template <class E>
         inline auto ifft(E&& e, std::ptrdiff_t axis = -1)
         {
             if constexpr (xtl::is_complex<typename std::decay<E>::type::value_type>::value)
             {
                 // check the length of the data on that axis
-                const std::size_t n = e.shape(axis);
+                const std::size_t n = e.shape(xt::normalize_axis(e.dimension(), axis));
                 if (n == 0)
                 {
                     XTENSOR_THROW(std::runtime_error, "Cannot take the iFFT along an empty dimention");
                 }
-                auto complex_args = xt::conj(e);
-                auto fft_res = xt::fft::fft(complex_args, axis);
-                fft_res = xt::conj(fft_res);
-                return fft_res;
+                return detail::fft_impl<true>(std::forward<E>(e), axis);
             }
             else
             {
@@ -179,6 +287,190 @@ namespace xt
             }
         }
 
+        /**
+         * @brief FFT of an Nd array over several axes
+         *
+         * Each axis is transformed with the cached plan of its length, lanes
+         * of an axis are processed in parallel when TBB or OpenMP is enabled.
+         * @param e an Nd expression to be transformed to the fourier domain
+         * @param axes the axes along which to perform the FFT
+         * @return a transformed xarray of the specified precision
+         */
+        template <class E, class X = std::vector<std::ptrdiff_t>>
+        inline auto fftn(E&& e, const X& axes)
+        {
+            using value_type = typename std::decay_t<E>::value_type;
+            if constexpr (xtl::is_complex<value_type>::value)
+            {
+                return detail::fftn_impl<false>(std::forward<E>(e), axes);
+            }
+            else
+            {
+                return fftn(xt::cast<std::complex<value_type>>(e), axes);
+            }
+        }
+
+        /**
+         * @brief FFT of an Nd array over all its axes
+         */
+        template <class E>
+        inline auto fftn(E&& e)
+        {
+            std::vector<std::ptrdiff_t> axes(e.dimension());
+            std::iota(axes.begin(), axes.end(), std::ptrdiff_t(0));
+            return fftn(std::forward<E>(e), axes);
+        }
+
+        /**
+         * @brief unnormalized inverse FFT of an Nd array over several axes
+         */
+        template <class E, class X = std::vector<std::ptrdiff_t>>
+        inline auto ifftn(E&& e, const X& axes)
+        {
+            using value_type = typename std::decay_t<E>::value_type;
+            if constexpr (xtl::is_complex<value_type>::value)
+            {
+                return detail::fftn_impl<true>(std::forward<E>(e), axes);
+            }
+            else
+            {
+                return ifftn(xt::cast<std::complex<value_type>>(e), axes);
+            }
+        }
+
+        /**
+         * @brief unnormalized inverse FFT of an Nd array over all its axes
+         */
+        template <class E>
+        inline auto ifftn(E&& e)
+        {
+            std::vector<std::ptrdiff_t> axes(e.dimension());
+            std::iota(axes.begin(), axes.end(), std::ptrdiff_t(0));
+            return ifftn(std::forward<E>(e), axes);
+        }
+
+        /**
+         * @brief 2D FFT over the two last axes of an Nd array
+         */
+        template <class E>
+        inline auto fft2(E&& e)
+        {
+            return fftn(std::forward<E>(e), std::vector<std::ptrdiff_t>{-2, -1});
+        }
+
+        /**
+         * @brief unnormalized 2D inverse FFT over the two last axes of an Nd array
+         */
+        template <class E>
+        inline auto ifft2(E&& e)
+        {
+            return ifftn(std::forward<E>(e), std::vector<std::ptrdiff_t>{-2, -1});
+        }
+
+        /**
+         * @brief 1D FFT of a real Nd array along a specified axis
+         *
+         * Only the n / 2 + 1 non-negative frequency bins of the Hermitian
+         * spectrum are computed, with a complex transform of half length
+         * when n is even.
+         * @param e an Nd real expression to be transformed to the fourier domain
+         * @param axis the axis along which to perform the 1D FFT
+         * @return an xarray of complex values with n / 2 + 1 elements along axis
+         */
+        template <class E>
+        inline auto rfft(E&& e, std::ptrdiff_t axis = -1)
+        {
+            using precision = typename std::decay_t<E>::value_type;
+            static_assert(!xtl::is_complex<precision>::value, "rfft requires a real expression");
+            const auto saxis = xt::normalize_axis(e.dimension(), axis);
+            const std::size_t n = e.shape(saxis);
+            if (n == 0)
+            {
+                XTENSOR_THROW(std::runtime_error, "Cannot take the rFFT along an empty dimention");
+            }
+            xt::xarray<precision, layout_type::row_major> in = xt::eval(e);
+            auto shape = in.shape();
+            shape[saxis] = n / 2 + 1;
+            auto out = xt::xarray<std::complex<precision>, layout_type::row_major>::from_shape(shape, uninitialized);
+            auto plan = get_rfft_plan<precision>(n);
+            detail::transform_lanes(
+                in,
+                out,
+                saxis,
+                [&plan](const precision* in_lane, std::complex<precision>* out_lane)
+                {
+                    plan->forward(in_lane, out_lane);
+                }
+            );
+            return out;
+        }
+
+        /**
+         * @brief unnormalized inverse of rfft along a specified axis
+         *
+         * Like ifft, the result is not divided by n: irfft(rfft(x)) is n * x.
+         * @param e an Nd expression holding the non-negative frequency bins
+         * @param n the length of the real output along axis, 2 * (m - 1) when 0,
+         *        m being the number of bins; missing bins are taken as zero and
+         *        extra bins are ignored
+         * @param axis the axis along which to perform the 1D inverse FFT
+         * @return an xarray of real values with n elements along axis
+         */
+        template <class E>
+        inline auto irfft(E&& e, std::size_t n = 0, std::ptrdiff_t axis = -1)
+        {
+            using value_type = typename std::decay_t<E>::value_type;
+            if constexpr (xtl::is_complex<value_type>::value)
+            {
+                using precision = typename value_type::value_type;
+                const auto saxis = xt::normalize_axis(e.dimension(), axis);
+                const std::size_t bins = e.shape(saxis);
+                if (n == 0)
+                {
+                    n = bins > 1 ? 2 * (bins - 1) : 0;
+                }
+                if (bins == 0 || n == 0)
+                {
+                    XTENSOR_THROW(std::runtime_error, "Cannot take the irFFT along an empty dimention");
+                }
+                xt::xarray<value_type, layout_type::row_major> in = xt::eval(e);
+                auto shape = in.shape();
+                shape[saxis] = n;
+                auto out = xt::xarray<precision, layout_type::row_major>::from_shape(shape, uninitialized);
+                auto plan = get_rfft_plan<precision>(n);
+                const std::size_t needed = plan->spectrum_size();
+                detail::transform_lanes(
+                    in,
+                    out,
+                    saxis,
+                    [&plan, bins, needed](const value_type* in_lane, precision* out_lane)
+                    {
+                        if (bins >= needed)
+                        {
+                            plan->backward(in_lane, out_lane);
+                        }
+                        else
+                        {
+                            // lanes may run concurrently, each thread pads in its own scratch
+                            auto& padded = detail::fft_scratch<precision, 2>(needed);
+                            std::copy(in_lane, in_lane + bins, padded.begin());
+                            std::fill(
+                                padded.begin() + static_cast<std::ptrdiff_t>(bins),
+                                padded.begin() + static_cast<std::ptrdiff_t>(needed),
+                                value_type(0)
+                            );
+                            plan->backward(padded.data(), out_lane);
+                        }
+                    }
+                );
+                return out;
+            }
+            else
+            {
+                return irfft(xt::cast<std::complex<value_type>>(e), n, axis);
+            }
+        }
+
         /*
          * @brief performs a circular fft convolution xvec and yvec must
          *        be the same shape.
@@ -225,3 +517,5 @@ namespace xt
 
     }
 }  // namespace xt::fft
+
+#endif
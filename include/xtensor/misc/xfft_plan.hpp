@@ -0,0 +1,863 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay and Wolf Vollprecht          *
+ * Copyright (c) QuantStack                                                 *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XTENSOR_FFT_PLAN_HPP
+#define XTENSOR_FFT_PLAN_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../core/xtensor_config.hpp"
+
+namespace xt
+{
+    namespace fft
+    {
+        /************
+         * fft_plan *
+         ************/
+
+        /**
+         * @brief Precomputed tables of an in-place FFT of a given size.
+         *
+         * Powers of 2 are transformed by an iterative radix-2 butterfly after a
+         * bit-reversal permutation. Other sizes are decomposed into radix 4, 2,
+         * 3, 5, 7 and generic odd prime stages, sizes with a prime factor larger
+         * than max_generic_radix use Bluestein's algorithm on a power of 2 size.
+         *
+         * A plan is immutable once built, so a single plan can be shared by all
+         * the threads transforming signals of its size. Plans are usually
+         * obtained with get_plan, which caches them.
+         *
+         * @tparam T the precision of the transformed complex values
+         */
+        template <class T>
+        class fft_plan
+        {
+        public:
+
+            using value_type = std::complex<T>;
+            using size_type = std::size_t;
+
+            static constexpr size_type max_generic_radix = 64;
+
+            explicit fft_plan(size_type n);
+
+            size_type size() const noexcept;
+
+            void forward(value_type* data) const;
+            void backward(value_type* data) const;
+
+        private:
+
+            enum class algorithm
+            {
+                radix2,
+                mixed_radix,
+                bluestein
+            };
+
+            void init_radix2();
+            void init_mixed_radix();
+            void init_bluestein();
+
+            template <bool Inverse>
+            void execute(value_type* data) const;
+
+            template <bool Inverse>
+            void radix2(value_type* data) const;
+
+            template <bool Inverse>
+            void mixed_radix(value_type* out, const value_type* in, size_type fstride, const size_type* factors) const;
+
+            template <bool Inverse>
+            void butterfly2(value_type* out, size_type fstride, size_type m) const;
+
+            template <bool Inverse>
+            void butterfly4(value_type* out, size_type fstride, size_type m) const;
+
+            template <std::size_t P, bool Inverse>
+            void butterfly_odd(value_type* out, size_type fstride, size_type m) const;
+
+            template <bool Inverse>
+            void butterfly_generic(value_type* out, size_type fstride, size_type m, size_type p) const;
+
+            template <bool Inverse>
+            void bluestein(value_type* data) const;
+
+            template <bool Inverse>
+            value_type twiddle(size_type i) const noexcept;
+
+            size_type m_size;
+            algorithm m_algorithm;
+            // radix2: bit-reversal swaps and the twiddles of every stage
+            // mixed_radix: (radix, stage length) pairs and the n roots of unity
+            // bluestein: the chirp and the transformed convolution kernel
+            std::vector<std::pair<size_type, size_type>> m_swaps;
+            std::vector<size_type> m_factors;
+            std::vector<value_type> m_twiddles;
+            std::vector<value_type> m_kernel;
+            std::shared_ptr<const fft_plan> m_subplan;
+        };
+
+        /*************
+         * rfft_plan *
+         *************/
+
+        /**
+         * @brief Precomputed tables of the FFT of a real signal of a given size.
+         *
+         * Only the n / 2 + 1 first bins of the Hermitian spectrum are computed.
+         * For an even size, the real signal is packed into a complex signal of
+         * size n / 2 whose transform is split into the spectrum of the even
+         * and odd samples. Odd sizes go through a complex transform of size n.
+         *
+         * @tparam T the precision of the transformed real values
+         */
+        template <class T>
+        class rfft_plan
+        {
+        public:
+
+            using value_type = std::complex<T>;
+            using size_type = std::size_t;
+
+            explicit rfft_plan(size_type n);
+
+            size_type size() const noexcept;
+            size_type spectrum_size() const noexcept;
+
+            void forward(const T* in, value_type* out) const;
+            void backward(const value_type* in, T* out) const;
+
+        private:
+
+            size_type m_size;
+            std::shared_ptr<const fft_plan<T>> m_plan;
+            std::vector<value_type> m_twiddles;
+        };
+
+        template <class T>
+        std::shared_ptr<const fft_plan<T>> get_plan(std::size_t n);
+
+        template <class T>
+        std::shared_ptr<const rfft_plan<T>> get_rfft_plan(std::size_t n);
+
+        template <class T>
+        void clear_plan_cache();
+
+        std::size_t next_fast_length(std::size_t n) noexcept;
+
+        /***************************
+         * fft_plan implementation *
+         ***************************/
+
+        namespace detail
+        {
+            inline bool is_power_of_two(std::size_t n) noexcept
+            {
+                return n != 0 && !(n & (n - 1));
+            }
+
+            // std::complex multiplication checks for NaN / infinite operands,
+            // which prevents vectorization of the butterfly loops.
+            template <class T>
+            inline std::complex<T> cmul(const std::complex<T>& a, const std::complex<T>& b) noexcept
+            {
+                return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+            }
+
+            template <class T>
+            inline std::complex<T> cmul_conj(const std::complex<T>& a, const std::complex<T>& b) noexcept
+            {
+                return {a.real() * b.real() + a.imag() * b.imag(), a.imag() * b.real() - a.real() * b.imag()};
+            }
+
+            // exp(-2i * pi * k / n) computed in extended precision
+            template <class T>
+            inline std::complex<T> unit_root(std::size_t k, std::size_t n)
+            {
+                constexpr long double pi = 3.141592653589793238462643383279502884l;
+                const long double angle = -2.l * pi * static_cast<long double>(k) / static_cast<long double>(n);
+                return {static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle))};
+            }
+
+            // Slot 0 is used by fft_plan, slot 1 by the real transforms built on top of it
+            // and slot 2 by irfft to pad truncated spectra
+            template <class T, int Slot = 0>
+            inline std::vector<std::complex<T>>& fft_scratch(std::size_t size)
+            {
+                thread_local std::vector<std::complex<T>> buffer;
+                if (buffer.size() < size)
+                {
+                    buffer.resize(size);
+                }
+                return buffer;
+            }
+        }
+
+        /**
+         * Builds the tables of a transform of size \c n.
+         * @param n the size of the transform, must be positive
+         */
+        template <class T>
+        inline fft_plan<T>::fft_plan(size_type n)
+            : m_size(n)
+            , m_algorithm(algorithm::radix2)
+        {
+            if (n == 0)
+            {
+                XTENSOR_THROW(std::runtime_error, "FFT plan requires a positive size");
+            }
+            if (detail::is_power_of_two(n))
+            {
+                init_radix2();
+            }
+            else
+            {
+                init_mixed_radix();
+            }
+        }
+
+        template <class T>
+        inline void fft_plan<T>::init_radix2()
+        {
+            m_algorithm = algorithm::radix2;
+            size_type bits = 0;
+            while ((size_type(1) << bits) < m_size)
+            {
+                ++bits;
+            }
+            for (size_type i = 0; i < m_size; ++i)
+            {
+                size_type r = 0;
+                for (size_type b = 0; b < bits; ++b)
+                {
+                    r |= ((i >> b) & size_type(1)) << (bits - 1 - b);
+                }
+                if (i < r)
+                {
+                    m_swaps.emplace_back(i, r);
+                }
+            }
+
+            // The twiddles of the stage combining blocks of size half are stored
+            // contiguously at offset half - 1.
+            m_twiddles.reserve(m_size - 1);
+            for (size_type half = 1; half < m_size; half <<= 1)
+            {
+                for (size_type j = 0; j < half; ++j)
+                {
+                    m_twiddles.push_back(detail::unit_root<T>(j, 2 * half));
+                }
+            }
+        }
+
+        template <class T>
+        inline void fft_plan<T>::init_mixed_radix()
+        {
+            // Radix 4 first, then 2, then increasing odd factors
+            size_type n = m_size;
+            size_type p = 4;
+            while (n > 1)
+            {
+                while (n % p != 0)
+                {
+                    p = p == 4 ? 2 : (p == 2 ? 3 : p + 2);
+                    if (p * p > n)
+                    {
+                        p = n;
+                    }
+                }
+                if (p > max_generic_radix)
+                {
+                    m_factors.clear();
+                    init_bluestein();
+                    return;
+                }
+                n /= p;
+                m_factors.push_back(p);
+                m_factors.push_back(n);
+            }
+
+            m_algorithm = algorithm::mixed_radix;
+            m_twiddles.reserve(m_size);
+            for (size_type k = 0; k < m_size; ++k)
+            {
+                m_twiddles.push_back(detail::unit_root<T>(k, m_size));
+            }
+        }
+
+        template <class T>
+        inline void fft_plan<T>::init_bluestein()
+        {
+            m_algorithm = algorithm::bluestein;
+            size_type m = 1;
+            while (m < 2 * m_size - 1)
+            {
+                m <<= 1;
+            }
+            m_subplan = std::make_shared<const fft_plan>(m);
+
+            // chirp w_k = exp(-i * pi * k^2 / n), k^2 is reduced modulo 2n
+            m_twiddles.reserve(m_size);
+            for (size_type k = 0; k < m_size; ++k)
+            {
+                const size_type k2 = static_cast<size_type>(
+                    (static_cast<unsigned long long>(k) * k) % (2ull * m_size)
+                );
+                m_twiddles.push_back(detail::unit_root<T>(k2, 2 * m_size));
+            }
+
+            // Transformed kernel of the circular convolution, scaled by 1 / m
+            // so that the backward transform needs no normalization.
+            m_kernel.assign(m, value_type(0));
+            m_kernel[0] = std::conj(m_twiddles[0]);
+            for (size_type k = 1; k < m_size; ++k)
+            {
+                m_kernel[k] = std::conj(m_twiddles[k]);
+                m_kernel[m - k] = std::conj(m_twiddles[k]);
+            }
+            m_subplan->forward(m_kernel.data());
+            const T scale = T(1) / static_cast<T>(m);
+            for (auto& v : m_kernel)
+            {
+                v *= scale;
+            }
+        }
+
+        template <class T>
+        inline auto fft_plan<T>::size() const noexcept -> size_type
+        {
+            return m_size;
+        }
+
+        /**
+         * Replaces the \c size() contiguous values pointed to by \c data with
+         * their discrete Fourier transform.
+         */
+        template <class T>
+        inline void fft_plan<T>::forward(value_type* data) const
+        {
+            execute<false>(data);
+        }
+
+        /**
+         * Replaces the \c size() contiguous values pointed to by \c data with
+         * their unnormalized inverse discrete Fourier transform.
+         */
+        template <class T>
+        inline void fft_plan<T>::backward(value_type* data) const
+        {
+            execute<true>(data);
+        }
+
+        template <class T>
+        template <bool Inverse>
+        inline void fft_plan<T>::execute(value_type* data) const
+        {
+            switch (m_algorithm)
+            {
+                case algorithm::radix2:
+                    radix2<Inverse>(data);
+                    break;
+                case algorithm::mixed_radix:
+                {
+                    // The decimation in time reads the input with growing strides,
+                    // it needs a copy of the input.
+                    auto& buffer = detail::fft_scratch<T>(m_size);
+                    std::copy(data, data + m_size, buffer.data());
+                    mixed_radix<Inverse>(data, buffer.data(), 1, m_factors.data());
+                    break;
+                }
+                case algorithm::bluestein:
+                    bluestein<Inverse>(data);
+                    break;
+            }
+        }
+
+        template <class T>
+        template <bool Inverse>
+        inline auto fft_plan<T>::twiddle(size_type i) const noexcept -> value_type
+        {
+            return Inverse ? std::conj(m_twiddles[i]) : m_twiddles[i];
+        }
+
+        template <class T>
+        template <bool Inverse>
+        inline void fft_plan<T>::radix2(value_type* data) const
+        {
+            for (const auto& s : m_swaps)
+            {
+                std::swap(data[s.first], data[s.second]);
+            }
+            for (size_type half = 1; half < m_size; half <<= 1)
+            {
+                const value_type* w = m_twiddles.data() + (half - 1);
+                for (size_type i = 0; i < m_size; i += 2 * half)
+                {
+                    value_type* a = data + i;
+                    value_type* b = a + half;
+                    for (size_type j = 0; j < half; ++j)
+                    {
+                        const value_type t = Inverse ? detail::cmul_conj(b[j], w[j]) : detail::cmul(b[j], w[j]);
+                        b[j] = a[j] - t;
+                        a[j] += t;
+                    }
+                }
+            }
+        }
+
+        /**
+         * Decimation in time: the p sub-transforms of length m = factors[1] of
+         * the input read with stride fstride * p are computed into consecutive
+         * blocks of out, then combined by a radix p = factors[0] butterfly.
+         */
+        template <class T>
+        template <bool Inverse>
+        inline void fft_plan<T>::mixed_radix(
+            value_type* out,
+            const value_type* in,
+            size_type fstride,
+            const size_type* factors
+        ) const
+        {
+            const size_type p = factors[0];
+            const size_type m = factors[1];
+            if (m == 1)
+            {
+                for (size_type q = 0; q < p; ++q)
+                {
+                    out[q] = in[q * fstride];
+                }
+            }
+            else
+            {
+                for (size_type q = 0; q < p; ++q)
+                {
+                    mixed_radix<Inverse>(out + q * m, in + q * fstride, fstride * p, factors + 2);
+                }
+            }
+
+            switch (p)
+            {
+                case 2:
+                    butterfly2<Inverse>(out, fstride, m);
+                    break;
+                case 3:
+                    butterfly_odd<3, Inverse>(out, fstride, m);
+                    break;
+                case 4:
+                    butterfly4<Inverse>(out, fstride, m);
+                    break;
+                case 5:
+                    butterfly_odd<5, Inverse>(out, fstride, m);
+                    break;
+                case 7:
+                    butterfly_odd<7, Inverse>(out, fstride, m);
+                    break;
+                default:
+                    butterfly_generic<Inverse>(out, fstride, m, p);
+                    break;
+            }
+        }
+
+        template <class T>
+        template <bool Inverse>
+        inline void fft_plan<T>::butterfly2(value_type* out, size_type fstride, size_type m) const
+        {
+            value_type* out2 = out + m;
+            for (size_type k = 0; k < m; ++k)
+            {
+                const value_type t = detail::cmul(out2[k], twiddle<Inverse>(k * fstride));
+                out2[k] = out[k] - t;
+                out[k] += t;
+            }
+        }
+
+        template <class T>
+        template <bool Inverse>
+        inline void fft_plan<T>::butterfly4(value_type* out, size_type fstride, size_type m) const
+        {
+            for (size_type k = 0; k < m; ++k)
+            {
+                value_type* f = out + k;
+                const value_type s0 = detail::cmul(f[m], twiddle<Inverse>(k * fstride));
+                const value_type s1 = detail::cmul(f[2 * m], twiddle<Inverse>(2 * k * fstride));
+                const value_type s2 = detail::cmul(f[3 * m], twiddle<Inverse>(3 * k * fstride));
+                const value_type s5 = f[0] - s1;
+                const value_type s6 = f[0] + s1;
+                const value_type s3 = s0 + s2;
+                const value_type s4 = s0 - s2;
+                f[0] = s6 + s3;
+                f[2 * m] = s6 - s3;
+                // s4 rotated by -i (forward) or +i (inverse)
+                const value_type r = Inverse ? value_type(-s4.imag(), s4.real()) : value_type(s4.imag(), -s4.real());
+                f[m] = s5 + r;
+                f[3 * m] = s5 - r;
+            }
+        }
+
+        /**
+         * Radix P butterfly for a small odd prime P, using the symmetry of the
+         * roots of unity: outputs k and P - k share the same real combination
+         * of the sums x_q + x_{P-q} and the differences x_q - x_{P-q}.
+         */
+        template <class T>
+        template <std::size_t P, bool Inverse>
+        inline void fft_plan<T>::butterfly_odd(value_type* out, size_type fstride, size_type m) const
+        {
+            constexpr std::size_t H = P / 2;
+            // cos(2 pi j / P) and sin(2 pi j / P), j = 0 .. P - 1
+            T c[P];
+            T s[P];
+            for (std::size_t j = 0; j < P; ++j)
+            {
+                const value_type w = m_twiddles[j * fstride * m];
+                c[j] = w.real();
+                s[j] = -w.imag();
+            }
+
+            for (size_type u = 0; u < m; ++u)
+            {
+                value_type x[P];
+                x[0] = out[u];
+                for (std::size_t q = 1; q < P; ++q)
+                {
+                    x[q] = detail::cmul(out[q * m + u], twiddle<Inverse>(q * u * fstride));
+                }
+                value_type a[H + 1];
+                value_type b[H + 1];
+                value_type y0 = x[0];
+                for (std::size_t q = 1; q <= H; ++q)
+                {
+                    a[q] = x[q] + x[P - q];
+                    b[q] = x[q] - x[P - q];
+                    y0 += a[q];
+                }
+                out[u] = y0;
+                for (std::size_t k = 1; k <= H; ++k)
+                {
+                    value_type re = x[0];
+                    value_type im(0);
+                    for (std::size_t q = 1; q <= H; ++q)
+                    {
+                        const std::size_t j = (q * k) % P;
+                        re += a[q] * c[j];
+                        im += b[q] * s[j];
+                    }
+                    // forward: X_k = re - i * im, inverse: X_k = re + i * im
+                    const value_type r = Inverse ? value_type(-im.imag(), im.real())
+                                                 : value_type(im.imag(), -im.real());
+                    out[k * m + u] = re + r;
+                    out[(P - k) * m + u] = re - r;
+                }
+            }
+        }
+
+        template <class T>
+        template <bool Inverse>
+        inline void fft_plan<T>::butterfly_generic(value_type* out, size_type fstride, size_type m, size_type p) const
+        {
+            std::vector<value_type> scratch(p);
+            for (size_type u = 0; u < m; ++u)
+            {
+                for (size_type q = 0; q < p; ++q)
+                {
+                    scratch[q] = out[q * m + u];
+                }
+                for (size_type q1 = 0; q1 < p; ++q1)
+                {
+                    const size_type k = u + q1 * m;
+                    const size_type step = fstride * k % m_size;
+                    size_type index = 0;
+                    value_type acc = scratch[0];
+                    for (size_type q = 1; q < p; ++q)
+                    {
+                        index += step;
+                        if (index >= m_size)
+                        {
+                            index -= m_size;
+                        }
+                        acc += detail::cmul(scratch[q], twiddle<Inverse>(index));
+                    }
+                    out[k] = acc;
+                }
+            }
+        }
+
+        template <class T>
+        template <bool Inverse>
+        inline void fft_plan<T>::bluestein(value_type* data) const
+        {
+            const size_type m = m_subplan->size();
+            auto& buffer = detail::fft_scratch<T>(m);
+            for (size_type k = 0; k < m_size; ++k)
+            {
+                const value_type x = Inverse ? std::conj(data[k]) : data[k];
+                buffer[k] = detail::cmul(x, m_twiddles[k]);
+            }
+            std::fill(buffer.begin() + static_cast<std::ptrdiff_t>(m_size), buffer.begin() + static_cast<std::ptrdiff_t>(m), value_type(0));
+            m_subplan->forward(buffer.data());
+            for (size_type k = 0; k < m; ++k)
+            {
+                buffer[k] = detail::cmul(buffer[k], m_kernel[k]);
+            }
+            m_subplan->backward(buffer.data());
+            for (size_type k = 0; k < m_size; ++k)
+            {
+                const value_type y = detail::cmul(buffer[k], m_twiddles[k]);
+                data[k] = Inverse ? std::conj(y) : y;
+            }
+        }
+
+        /****************************
+         * rfft_plan implementation *
+         ****************************/
+
+        /**
+         * Builds the tables of a real transform of size \c n.
+         * @param n the size of the real signal, must be positive
+         */
+        template <class T>
+        inline rfft_plan<T>::rfft_plan(size_type n)
+            : m_size(n)
+        {
+            if (n == 0)
+            {
+                XTENSOR_THROW(std::runtime_error, "FFT plan requires a positive size");
+            }
+            if (n % 2 == 0)
+            {
+                m_plan = get_plan<T>(n / 2);
+                m_twiddles.reserve(n / 2 + 1);
+                for (size_type k = 0; k <= n / 2; ++k)
+                {
+                    m_twiddles.push_back(detail::unit_root<T>(k, n));
+                }
+            }
+            else
+            {
+                m_plan = get_plan<T>(n);
+            }
+        }
+
+        /**
+         * Returns the size of the real signal.
+         */
+        template <class T>
+        inline auto rfft_plan<T>::size() const noexcept -> size_type
+        {
+            return m_size;
+        }
+
+        /**
+         * Returns the number of bins of the spectrum, \c size() / 2 + 1.
+         */
+        template <class T>
+        inline auto rfft_plan<T>::spectrum_size() const noexcept -> size_type
+        {
+            return m_size / 2 + 1;
+        }
+
+        /**
+         * Computes the \c spectrum_size() first bins of the discrete Fourier
+         * transform of the \c size() real values pointed to by \c in.
+         */
+        template <class T>
+        inline void rfft_plan<T>::forward(const T* in, value_type* out) const
+        {
+            if (m_size % 2 != 0)
+            {
+                auto& buffer = detail::fft_scratch<T, 1>(m_size);
+                std::copy(in, in + m_size, buffer.begin());
+                m_plan->forward(buffer.data());
+                std::copy(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(spectrum_size()), out);
+                return;
+            }
+
+            const size_type half = m_size / 2;
+            for (size_type j = 0; j < half; ++j)
+            {
+                out[j] = value_type(in[2 * j], in[2 * j + 1]);
+            }
+            m_plan->forward(out);
+
+            // Z = E + iO where E and O are the spectra of the even and odd samples,
+            // X_k = E_k + W_k O_k with E_k = (Z_k + conj(Z_{h-k})) / 2 and
+            // O_k = (Z_k - conj(Z_{h-k})) / 2i; bins k and h - k are computed together.
+            const value_type z0 = out[0];
+            out[0] = value_type(z0.real() + z0.imag(), T(0));
+            out[half] = value_type(z0.real() - z0.imag(), T(0));
+            for (size_type k = 1; 2 * k <= half; ++k)
+            {
+                const value_type zk = out[k];
+                const value_type zhk = out[half - k];
+                const value_type e = T(0.5) * (zk + std::conj(zhk));
+                const value_type d = zk - std::conj(zhk);
+                const value_type o = T(0.5) * value_type(d.imag(), -d.real());
+                out[k] = e + detail::cmul(m_twiddles[k], o);
+                out[half - k] = std::conj(e) + detail::cmul(m_twiddles[half - k], std::conj(o));
+            }
+        }
+
+        /**
+         * Computes the \c size() real values of the unnormalized inverse
+         * discrete Fourier transform of the \c spectrum_size() bins pointed
+         * to by \c in. The imaginary parts of the first bin and, for an even
+         * size, of the last one are ignored.
+         */
+        template <class T>
+        inline void rfft_plan<T>::backward(const value_type* in, T* out) const
+        {
+            if (m_size % 2 != 0)
+            {
+                auto& buffer = detail::fft_scratch<T, 1>(m_size);
+                buffer[0] = value_type(in[0].real(), T(0));
+                for (size_type k = 1; k < spectrum_size(); ++k)
+                {
+                    buffer[k] = in[k];
+                    buffer[m_size - k] = std::conj(in[k]);
+                }
+                m_plan->backward(buffer.data());
+                for (size_type j = 0; j < m_size; ++j)
+                {
+                    out[j] = buffer[j].real();
+                }
+                return;
+            }
+
+            const size_type half = m_size / 2;
+            auto& buffer = detail::fft_scratch<T, 1>(half);
+            for (size_type k = 0; k < half; ++k)
+            {
+                const value_type xk = k == 0 ? value_type(in[0].real(), T(0)) : in[k];
+                const value_type xhk = k == 0 ? value_type(in[half].real(), T(0)) : in[half - k];
+                const value_type e = xk + std::conj(xhk);
+                const value_type o = detail::cmul_conj(xk - std::conj(xhk), m_twiddles[k]);
+                buffer[k] = e + value_type(-o.imag(), o.real());
+            }
+            m_plan->backward(buffer.data());
+            for (size_type j = 0; j < half; ++j)
+            {
+                out[2 * j] = buffer[j].real();
+                out[2 * j + 1] = buffer[j].imag();
+            }
+        }
+
+        namespace detail
+        {
+            template <class P>
+            struct plan_cache
+            {
+                std::mutex mutex;
+                std::unordered_map<std::size_t, std::shared_ptr<const P>> plans;
+            };
+
+            template <class P>
+            inline plan_cache<P>& get_plan_cache()
+            {
+                static plan_cache<P> cache;
+                return cache;
+            }
+
+            template <class P>
+            inline std::shared_ptr<const P> get_cached_plan(std::size_t n)
+            {
+                auto& cache = get_plan_cache<P>();
+                std::lock_guard<std::mutex> lock(cache.mutex);
+                auto it = cache.plans.find(n);
+                if (it == cache.plans.end())
+                {
+                    it = cache.plans.emplace(n, std::make_shared<const P>(n)).first;
+                }
+                return it->second;
+            }
+
+            template <class P>
+            inline void clear_plan_cache()
+            {
+                auto& cache = get_plan_cache<P>();
+                std::lock_guard<std::mutex> lock(cache.mutex);
+                cache.plans.clear();
+            }
+        }
+
+        /**
+         * Returns the plan of size \c n for the precision \c T, building it on
+         * first use. This function is thread-safe.
+         */
+        template <class T>
+        inline std::shared_ptr<const fft_plan<T>> get_plan(std::size_t n)
+        {
+            return detail::get_cached_plan<fft_plan<T>>(n);
+        }
+
+        /**
+         * Returns the real transform plan of size \c n for the precision \c T,
+         * building it on first use. This function is thread-safe.
+         */
+        template <class T>
+        inline std::shared_ptr<const rfft_plan<T>> get_rfft_plan(std::size_t n)
+        {
+            return detail::get_cached_plan<rfft_plan<T>>(n);
+        }
+
+        /**
+         * Releases the cached plans of precision \c T. Plans still referenced
+         * elsewhere stay alive until their last owner releases them.
+         */
+        template <class T>
+        inline void clear_plan_cache()
+        {
+            detail::clear_plan_cache<rfft_plan<T>>();
+            detail::clear_plan_cache<fft_plan<T>>();
+        }
+
+        /**
+         * Returns the smallest size greater than or equal to \c n whose only
+         * prime factors are 2, 3 and 5, for which fft_plan is the fastest.
+         */
+        inline std::size_t next_fast_length(std::size_t n) noexcept
+        {
+            if (n <= 1)
+            {
+                return 1;
+            }
+            std::size_t best = std::size_t(1);
+            while (best < n)
+            {
+                best <<= 1;
+            }
+            for (std::size_t p5 = 1; p5 < best; p5 *= 5)
+            {
+                for (std::size_t p35 = p5; p35 < best; p35 *= 3)
+                {
+                    std::size_t candidate = p35;
+                    while (candidate < n)
+                    {
+                        candidate <<= 1;
+                    }
+                    best = std::min(best, candidate);
+                }
+            }
+            return best;
+        }
+    }
+}
+
+#endif
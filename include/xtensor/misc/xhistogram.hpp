@@ -14,9 +14,15 @@
 #ifndef XTENSOR_HISTOGRAM_HPP
 #define XTENSOR_HISTOGRAM_HPP
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "../containers/xarray.hpp"
 #include "../containers/xtensor.hpp"
 #include "../misc/xset_operation.hpp"
 #include "../misc/xsort.hpp"
+#include "../utils/xutils.hpp"
 #include "../views/xview.hpp"
 
 using namespace xt::placeholders;
@@ -51,11 +57,68 @@ namespace xt
 
     namespace detail
     {
+        // Minimum number of values binned by one task of the parallel histogram
+        constexpr std::size_t histogram_chunk = 32768;
+
+        // Number of bin indices computed at once, before their weights are accumulated
+        constexpr std::size_t histogram_block = 256;
+
+        /**
+         * Accumulates the weights of the n values into n_bins bins. bin_block(first, len, idx)
+         * writes the bins of the values [first, first + len) to idx, n_bins for the values
+         * that fall out of the edges. Every task accumulates into its own bins, which are
+         * added to the result in task order once all tasks are done, so that the result
+         * does not depend on the scheduling. A task bins at least n_bins values, which
+         * bounds the size of the partial bins by the size of the data.
+         */
+        template <class T, class E, class F>
+        inline xtensor<T, 1> histogram_count(std::size_t n, std::size_t n_bins, const E& weights, F&& bin_block)
+        {
+            const std::size_t chunk = std::max(histogram_chunk, n_bins);
+            const std::size_t tasks = (n + chunk - 1) / chunk;
+            // The additional bin of every task collects the values out of the edges
+            const std::size_t stride = n_bins + 1;
+            std::vector<T> partial(tasks * stride, T(0));
+            parallel_chunks(
+                tasks,
+                [&](std::size_t first_task, std::size_t last_task)
+                {
+                    std::array<std::size_t, histogram_block> idx;
+                    for (std::size_t task = first_task; task < last_task; ++task)
+                    {
+                        T* local = partial.data() + task * stride;
+                        const std::size_t last = std::min((task + 1) * chunk, n);
+                        for (std::size_t first = task * chunk; first < last; first += histogram_block)
+                        {
+                            const std::size_t len = std::min(histogram_block, last - first);
+                            bin_block(first, len, idx.data());
+                            for (std::size_t j = 0; j < len; ++j)
+                            {
+                                local[idx[j]] += static_cast<T>(weights(first + j));
+                            }
+                        }
+                    }
+                }
+            );
+
+            xtensor<T, 1> count = zeros<T>({n_bins});
+            for (std::size_t task = 0; task < tasks; ++task)
+            {
+                const T* local = partial.data() + task * stride;
+                for (std::size_t k = 0; k < n_bins; ++k)
+                {
+                    count(k) += local[k];
+                }
+            }
+            return count;
+        }
+
         template <class R = double, class E1, class E2, class E3>
         inline auto histogram_imp(E1&& data, E2&& bin_edges, E3&& weights, bool density, bool equal_bins)
         {
             using size_type = common_size_type_t<std::decay_t<E1>, std::decay_t<E2>, std::decay_t<E3>>;
             using value_type = typename std::decay_t<E3>::value_type;
+            using edge_type = typename std::decay_t<E2>::value_type;
 
             XTENSOR_ASSERT(data.dimension() == 1);
             XTENSOR_ASSERT(weights.dimension() == 1);
@@ -64,57 +127,69 @@ namespace xt
             XTENSOR_ASSERT(bin_edges.size() >= 2);
             XTENSOR_ASSERT(std::is_sorted(bin_edges.cbegin(), bin_edges.cend()));
 
-            size_t n_bins = bin_edges.size() - 1;
-            xt::xtensor<value_type, 1> count = xt::zeros<value_type>({n_bins});
+            const std::size_t n_bins = bin_edges.size() - 1;
+            xt::xtensor<value_type, 1> count;
 
             if (equal_bins)
             {
-                std::array<typename std::decay_t<E2>::value_type, 2> bounds = xt::minmax(bin_edges)();
-                auto left = static_cast<double>(bounds[0]);
-                auto right = static_cast<double>(bounds[1]);
-                double norm = 1. / (right - left);
-                for (size_t i = 0; i < data.size(); ++i)
-                {
-                    auto v = static_cast<double>(data(i));
-                    // left and right are not bounds of data
-                    if (v >= left && v < right)
-                    {
-                        auto i_bin = static_cast<size_t>(static_cast<double>(n_bins) * (v - left) * norm);
-                        count(i_bin) += weights(i);
-                    }
-                    else if (v == right)
+                std::array<edge_type, 2> bounds = xt::minmax(bin_edges)();
+                const auto left = static_cast<double>(bounds[0]);
+                const auto right = static_cast<double>(bounds[1]);
+                const double norm = 1. / (right - left);
+                const auto nb = static_cast<double>(n_bins);
+                // Branchless over a block of values so that the computation of the
+                // bin indices is vectorized
+                count = histogram_count<value_type>(
+                    data.size(),
+                    n_bins,
+                    weights,
+                    [&](std::size_t first, std::size_t len, std::size_t* idx)
                     {
-                        count(n_bins - 1) += weights(i);
+                        std::array<double, histogram_block> values;
+                        for (std::size_t j = 0; j < len; ++j)
+                        {
+                            values[j] = static_cast<double>(data(first + j));
+                        }
+                        for (std::size_t j = 0; j < len; ++j)
+                        {
+                            const double v = values[j];
+                            // left and right are not bounds of data
+                            const bool inside = v >= left && v < right;
+                            const double pos = inside ? nb * (v - left) * norm : 0.;
+                            const std::size_t bin = std::min(static_cast<std::size_t>(pos), n_bins - 1);
+                            idx[j] = inside ? bin : (v == right ? n_bins - 1 : n_bins);
+                        }
                     }
-                }
+                );
             }
             else
             {
-                auto sorter = xt::argsort(data);
-
-                size_type ibin = 0;
-
-                for (auto& idx : sorter)
-                {
-                    auto item = data[idx];
-
-                    if (item < bin_edges[0])
-                    {
-                        continue;
-                    }
-
-                    if (item > bin_edges[n_bins])
-                    {
-                        break;
-                    }
-
-                    while (item >= bin_edges[ibin + 1] && ibin < n_bins - 1)
+                // Binary search of every value in the edges, the last bin
+                // includes its right edge
+                const std::vector<edge_type> edges(bin_edges.cbegin(), bin_edges.cend());
+                count = histogram_count<value_type>(
+                    data.size(),
+                    n_bins,
+                    weights,
+                    [&](std::size_t first, std::size_t len, std::size_t* idx)
                     {
-                        ++ibin;
+                        for (std::size_t j = 0; j < len; ++j)
+                        {
+                            const auto item = data(first + j);
+                            if (item >= edges.front() && item <= edges.back())
+                            {
+                                const auto bin = static_cast<std::size_t>(
+                                    std::upper_bound(edges.cbegin(), edges.cend(), item) - edges.cbegin()
+                                );
+                                idx[j] = std::min(bin - 1, n_bins - 1);
+                            }
+                            else
+                            {
+                                idx[j] = n_bins;
+                            }
+                        }
                     }
-
-                    count[ibin] += weights[idx];
-                }
+                );
             }
 
             xt::xtensor<R, 1> prob = xt::cast<R>(count);
@@ -384,7 +459,7 @@ namespace xt
                 // edges
                 // - allocate
                 std::vector<size_t> shape = {bins + 1};
-                xt::xtensor<value_type, 1> bin_edges = xtensor<value_type, 1>::from_shape(shape);
+                xt::xtensor<value_type, 1> bin_edges = xtensor<value_type, 1>::from_shape(shape, uninitialized);
                 // - first/last edge
                 bin_edges[0] = left;
                 bin_edges[bins] = right;
@@ -502,6 +577,353 @@ namespace xt
         return histogram_bin_edges(std::forward<E1>(data), xt::ones<value_type>({n}), left, right, bins, mode);
     }
 
+    /*******************************
+     * histogramdd and histogram2d *
+     *******************************/
+
+    namespace detail
+    {
+        /**
+         * Histogram of n samples of dim coordinates, sample(i, d) being the coordinate
+         * d of the sample i. The bins of every sample are flattened into one index of
+         * the row-major histogram, samples out of the edges along any axis are ignored.
+         */
+        template <class R, class F, class T, class E>
+        inline xarray<R> histogramdd_imp(
+            std::size_t n,
+            F&& sample,
+            const std::vector<std::vector<T>>& edges,
+            const E& weights,
+            bool density
+        )
+        {
+            using value_type = typename std::decay_t<E>::value_type;
+
+            const std::size_t dim = edges.size();
+            std::vector<std::size_t> shape(dim);
+            std::vector<std::size_t> strides(dim);
+            std::size_t n_bins = 1;
+            for (std::size_t d = dim; d > 0; --d)
+            {
+                XTENSOR_ASSERT(edges[d - 1].size() >= 2);
+                XTENSOR_ASSERT(std::is_sorted(edges[d - 1].cbegin(), edges[d - 1].cend()));
+                shape[d - 1] = edges[d - 1].size() - 1;
+                strides[d - 1] = n_bins;
+                n_bins *= shape[d - 1];
+            }
+
+            auto count = histogram_count<value_type>(
+                n,
+                n_bins,
+                weights,
+                [&](std::size_t first, std::size_t len, std::size_t* idx)
+                {
+                    for (std::size_t j = 0; j < len; ++j)
+                    {
+                        std::size_t flat = 0;
+                        for (std::size_t d = 0; d < dim; ++d)
+                        {
+                            const auto item = sample(first + j, d);
+                            const auto& e = edges[d];
+                            if (!(item >= e.front() && item <= e.back()))
+                            {
+                                flat = n_bins;
+                                break;
+                            }
+                            const auto bin = static_cast<std::size_t>(
+                                std::upper_bound(e.cbegin(), e.cend(), item) - e.cbegin()
+                            );
+                            flat += std::min(bin - 1, shape[d] - 1) * strides[d];
+                        }
+                        idx[j] = flat;
+                    }
+                }
+            );
+
+            xarray<R> res = xt::cast<R>(count);
+            res.reshape(shape);
+
+            if (density)
+            {
+                // Normalized by the total weight and the volume of each bin
+                const R total = xt::sum(res)();
+                for (std::size_t k = 0; k < n_bins; ++k)
+                {
+                    R volume = R(1);
+                    for (std::size_t d = 0; d < dim; ++d)
+                    {
+                        const std::size_t i = (k / strides[d]) % shape[d];
+                        volume *= static_cast<R>(edges[d][i + 1] - edges[d][i]);
+                    }
+                    res.flat(k) /= volume * total;
+                }
+            }
+            return res;
+        }
+
+        template <class E>
+        inline std::vector<std::vector<typename E::value_type>> histogram_edges_vector(const std::vector<E>& bin_edges)
+        {
+            std::vector<std::vector<typename E::value_type>> res;
+            res.reserve(bin_edges.size());
+            for (const auto& e : bin_edges)
+            {
+                XTENSOR_ASSERT(e.dimension() == 1);
+                res.emplace_back(e.cbegin(), e.cend());
+            }
+            return res;
+        }
+
+        // Equal width bins between the minimum and the maximum of each coordinate
+        template <class F>
+        inline std::vector<std::vector<double>>
+        histogram_range_edges(std::size_t n, F&& sample, const std::vector<std::size_t>& bins)
+        {
+            std::vector<std::vector<double>> res(bins.size());
+            for (std::size_t d = 0; d < bins.size(); ++d)
+            {
+                XTENSOR_ASSERT(bins[d] > std::size_t(0));
+                double left = 0.;
+                double right = 1.;
+                if (n > 0)
+                {
+                    left = right = static_cast<double>(sample(std::size_t(0), d));
+                    for (std::size_t i = 1; i < n; ++i)
+                    {
+                        const auto v = static_cast<double>(sample(i, d));
+                        left = std::min(left, v);
+                        right = std::max(right, v);
+                    }
+                }
+                if (left == right)
+                {
+                    left -= 0.5;
+                    right += 0.5;
+                }
+                res[d].resize(bins[d] + 1);
+                const double width = (right - left) / static_cast<double>(bins[d]);
+                for (std::size_t i = 0; i < bins[d]; ++i)
+                {
+                    res[d][i] = left + static_cast<double>(i) * width;
+                }
+                res[d][bins[d]] = right;
+            }
+            return res;
+        }
+
+        template <class E>
+        inline auto histogram_sample_accessor(const E& data)
+        {
+            XTENSOR_ASSERT(data.dimension() == 2);
+            return [&data](std::size_t i, std::size_t d)
+            {
+                return data(i, d);
+            };
+        }
+
+        template <class E1, class E2>
+        inline auto histogram_sample_accessor(const E1& x, const E2& y)
+        {
+            XTENSOR_ASSERT(x.dimension() == 1);
+            XTENSOR_ASSERT(y.dimension() == 1);
+            XTENSOR_ASSERT(x.size() == y.size());
+            using value_type = std::common_type_t<typename E1::value_type, typename E2::value_type>;
+            return [&x, &y](std::size_t i, std::size_t d)
+            {
+                return d == 0 ? static_cast<value_type>(x(i)) : static_cast<value_type>(y(i));
+            };
+        }
+    }
+
+    /**
+     * @ingroup histogram
+     * @brief Compute the multi-dimensional histogram of a set of samples.
+     *
+     * @param data The samples, one row per sample and one column per coordinate.
+     * @param bin_edges The bin-edges of every coordinate, each 1-dimensional and monotonic.
+     * @param weights Weight factors corresponding to each sample.
+     * @param density If true the resulting integral is normalized to 1. [default: false]
+     * @return An xarray<R> of shape (bin_edges[0].size()-1, ..., bin_edges[D-1].size()-1).
+     */
+    template <class R = double, class E1, class E2, class E3, XTL_REQUIRES(is_xexpression<std::decay_t<E3>>)>
+    inline auto histogramdd(E1&& data, const std::vector<E2>& bin_edges, E3&& weights, bool density = false)
+    {
+        XTENSOR_ASSERT(data.dimension() == 2 && data.shape()[1] == bin_edges.size());
+        XTENSOR_ASSERT(weights.size() == data.shape()[0]);
+        return detail::histogramdd_imp<R>(
+            data.shape()[0],
+            detail::histogram_sample_accessor(data),
+            detail::histogram_edges_vector(bin_edges),
+            weights,
+            density
+        );
+    }
+
+    /**
+     * @ingroup histogram
+     * @brief Compute the multi-dimensional histogram of a set of samples.
+     *
+     * @param data The samples, one row per sample and one column per coordinate.
+     * @param bin_edges The bin-edges of every coordinate, each 1-dimensional and monotonic.
+     * @param density If true the resulting integral is normalized to 1. [default: false]
+     * @return An xarray<R> of shape (bin_edges[0].size()-1, ..., bin_edges[D-1].size()-1).
+     */
+    template <class R = double, class E1, class E2>
+    inline auto histogramdd(E1&& data, const std::vector<E2>& bin_edges, bool density = false)
+    {
+        using value_type = typename std::decay_t<E1>::value_type;
+        return histogramdd<R>(
+            std::forward<E1>(data),
+            bin_edges,
+            xt::ones<value_type>({data.shape()[0]}),
+            density
+        );
+    }
+
+    /**
+     * @ingroup histogram
+     * @brief Compute the multi-dimensional histogram of a set of samples.
+     *
+     * The bins of every coordinate have equal width and span its range.
+     *
+     * @param data The samples, one row per sample and one column per coordinate.
+     * @param bins The number of bins of every coordinate.
+     * @param weights Weight factors corresponding to each sample.
+     * @param density If true the resulting integral is normalized to 1. [default: false]
+     * @return An xarray<R> of shape bins.
+     */
+    template <class R = double, class E1, class E3, XTL_REQUIRES(is_xexpression<std::decay_t<E3>>)>
+    inline auto histogramdd(E1&& data, const std::vector<std::size_t>& bins, E3&& weights, bool density = false)
+    {
+        XTENSOR_ASSERT(data.dimension() == 2 && data.shape()[1] == bins.size());
+        XTENSOR_ASSERT(weights.size() == data.shape()[0]);
+        auto sample = detail::histogram_sample_accessor(data);
+        return detail::histogramdd_imp<R>(
+            data.shape()[0],
+            sample,
+            detail::histogram_range_edges(data.shape()[0], sample, bins),
+            weights,
+            density
+        );
+    }
+
+    /**
+     * @ingroup histogram
+     * @brief Compute the multi-dimensional histogram of a set of samples.
+     *
+     * The bins of every coordinate have equal width and span its range.
+     *
+     * @param data The samples, one row per sample and one column per coordinate.
+     * @param bins The number of bins of every coordinate.
+     * @param density If true the resulting integral is normalized to 1. [default: false]
+     * @return An xarray<R> of shape bins.
+     */
+    template <class R = double, class E1>
+    inline auto histogramdd(E1&& data, const std::vector<std::size_t>& bins, bool density = false)
+    {
+        using value_type = typename std::decay_t<E1>::value_type;
+        return histogramdd<R>(std::forward<E1>(data), bins, xt::ones<value_type>({data.shape()[0]}), density);
+    }
+
+    /**
+     * @ingroup histogram
+     * @brief Compute the two-dimensional histogram of two data samples.
+     *
+     * @param x The first coordinate of the samples.
+     * @param y The second coordinate of the samples.
+     * @param x_edges The bin-edges along the first coordinate.
+     * @param y_edges The bin-edges along the second coordinate.
+     * @param weights Weight factors corresponding to each sample.
+     * @param density If true the resulting integral is normalized to 1. [default: false]
+     * @return An xtensor<R, 2> of shape (x_edges.size()-1, y_edges.size()-1).
+     */
+    template <
+        class R = double,
+        class E1,
+        class E2,
+        class E3,
+        class E4,
+        class E5,
+        XTL_REQUIRES(is_xexpression<std::decay_t<E5>>)>
+    inline auto histogram2d(E1&& x, E2&& y, E3&& x_edges, E4&& y_edges, E5&& weights, bool density = false)
+    {
+        using edge_type = std::common_type_t<
+            typename std::decay_t<E3>::value_type,
+            typename std::decay_t<E4>::value_type>;
+        XTENSOR_ASSERT(weights.size() == x.size());
+        XTENSOR_ASSERT(x_edges.dimension() == 1 && y_edges.dimension() == 1);
+        std::vector<std::vector<edge_type>> edges = {
+            std::vector<edge_type>(x_edges.cbegin(), x_edges.cend()),
+            std::vector<edge_type>(y_edges.cbegin(), y_edges.cend())
+        };
+        xtensor<R, 2> res = detail::histogramdd_imp<R>(
+            x.size(),
+            detail::histogram_sample_accessor(x, y),
+            edges,
+            weights,
+            density
+        );
+        return res;
+    }
+
+    /**
+     * @ingroup histogram
+     * @brief Compute the two-dimensional histogram of two data samples.
+     *
+     * @param x The first coordinate of the samples.
+     * @param y The second coordinate of the samples.
+     * @param x_edges The bin-edges along the first coordinate.
+     * @param y_edges The bin-edges along the second coordinate.
+     * @param density If true the resulting integral is normalized to 1. [default: false]
+     * @return An xtensor<R, 2> of shape (x_edges.size()-1, y_edges.size()-1).
+     */
+    template <
+        class R = double,
+        class E1,
+        class E2,
+        class E3,
+        class E4,
+        XTL_REQUIRES(is_xexpression<std::decay_t<E3>>, is_xexpression<std::decay_t<E4>>)>
+    inline auto histogram2d(E1&& x, E2&& y, E3&& x_edges, E4&& y_edges, bool density = false)
+    {
+        using value_type = typename std::decay_t<E1>::value_type;
+        return histogram2d<R>(
+            std::forward<E1>(x),
+            std::forward<E2>(y),
+            std::forward<E3>(x_edges),
+            std::forward<E4>(y_edges),
+            xt::ones<value_type>({x.size()}),
+            density
+        );
+    }
+
+    /**
+     * @ingroup histogram
+     * @brief Compute the two-dimensional histogram of two data samples.
+     *
+     * The bins of both coordinates have equal width and span their range.
+     *
+     * @param x The first coordinate of the samples.
+     * @param y The second coordinate of the samples.
+     * @param bins The number of bins along each coordinate. [default: 10]
+     * @param density If true the resulting integral is normalized to 1. [default: false]
+     * @return An xtensor<R, 2> of shape (bins, bins).
+     */
+    template <class R = double, class E1, class E2>
+    inline auto histogram2d(E1&& x, E2&& y, std::size_t bins = 10, bool density = false)
+    {
+        using value_type = typename std::decay_t<E1>::value_type;
+        auto sample = detail::histogram_sample_accessor(x, y);
+        xtensor<R, 2> res = detail::histogramdd_imp<R>(
+            x.size(),
+            sample,
+            detail::histogram_range_edges(x.size(), sample, {bins, bins}),
+            xt::ones<value_type>({x.size()}),
+            density
+        );
+        return res;
+    }
+
     /**
      * Count number of occurrences of each value in array of non-negative ints.
      *
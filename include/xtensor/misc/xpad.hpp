@@ -10,8 +10,15 @@
 #ifndef XTENSOR_PAD_HPP
 #define XTENSOR_PAD_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
 #include "../containers/xarray.hpp"
 #include "../containers/xtensor.hpp"
+#include "../core/xassign.hpp"
+#include "../utils/xutils.hpp"
 #include "../views/xstrided_view.hpp"
 #include "../views/xview.hpp"
 
@@ -57,147 +64,254 @@ namespace xt
 
             return true;
         }
-    }
 
-    /**
-     * @brief Pad an array.
-     *
-     * @param e The array.
-     * @param pad_width Number of values padded to the edges of each axis:
-     * `{{before_1, after_1}, ..., {before_N, after_N}}`.
-     * @param mode The type of algorithm to use. [default: `xt::pad_mode::constant`].
-     * @param constant_value The value to set the padded values for each axis
-     * (used in `xt::pad_mode::constant`).
-     * @return The padded array.
-     */
-    template <class E, class S = typename std::decay_t<E>::size_type, class V = typename std::decay_t<E>::value_type>
-    inline auto
-    pad(E&& e,
-        const std::vector<std::vector<S>>& pad_width,
-        pad_mode mode = pad_mode::constant,
-        V constant_value = 0)
-    {
-        XTENSOR_ASSERT(detail::check_pad_width(pad_width, e.shape()));
-
-        using size_type = typename std::decay_t<E>::size_type;
-        using return_type = temporary_type_t<E>;
-
-        // place the original array in the center
-
-        auto new_shape = e.shape();
-        xt::xstrided_slice_vector sv;
-        sv.reserve(e.shape().size());
-        for (size_type axis = 0; axis < e.shape().size(); ++axis)
+        // Operand and result of a pad or a tile, in block order
+        struct pad_sizes
         {
-            size_type nb = static_cast<size_type>(pad_width[axis][0]);
-            size_type ne = static_cast<size_type>(pad_width[axis][1]);
-            size_type ns = nb + e.shape(axis) + ne;
-            new_shape[axis] = ns;
-            sv.push_back(xt::range(nb, nb + e.shape(axis)));
-        }
-
-        if (mode == pad_mode::constant)
+            block_layout in;
+            block_layout out;
+            // padding before each dimension
+            std::vector<std::size_t> before;
+        };
+
+        inline pad_sizes make_pad_sizes(
+            const std::vector<std::size_t>& shape,
+            const std::vector<std::size_t>& out_shape,
+            const std::vector<std::size_t>& before,
+            layout_type l
+        )
         {
-            return_type out(new_shape, constant_value);
-            xt::strided_view(out, sv) = e;
-            return out;
+            block_layout in(shape, l);
+            std::vector<std::size_t> ordered_before = in.order(before);
+            return pad_sizes{std::move(in), block_layout(out_shape, l), std::move(ordered_before)};
         }
 
-        return_type out(new_shape);
-        xt::strided_view(out, sv) = e;
-
-        // construct padded regions based on original image
-
-        xt::xstrided_slice_vector svs(e.shape().size(), xt::all());
-        xt::xstrided_slice_vector svt(e.shape().size(), xt::all());
-
-        for (size_type axis = 0; axis < e.shape().size(); ++axis)
+        // Index of the element of the operand found at position p of a padded
+        // axis, the pattern of each mode is continued beyond the size of the axis.
+        inline std::size_t pad_source_index(pad_mode mode, std::size_t p, std::size_t before, std::size_t n)
         {
-            size_type nb = static_cast<size_type>(pad_width[axis][0]);
-            size_type ne = static_cast<size_type>(pad_width[axis][1]);
-
-            if (nb > static_cast<size_type>(0))
+            const auto q = static_cast<std::ptrdiff_t>(p) - static_cast<std::ptrdiff_t>(before);
+            const auto sn = static_cast<std::ptrdiff_t>(n);
+            auto positive_mod = [](std::ptrdiff_t a, std::ptrdiff_t m)
             {
-                svt[axis] = xt::range(0, nb);
-
-                if (mode == pad_mode::wrap || mode == pad_mode::periodic)
+                return ((a % m) + m) % m;
+            };
+            std::ptrdiff_t res = 0;
+            switch (mode)
+            {
+                case pad_mode::wrap:
+                case pad_mode::periodic:
+                    res = positive_mod(q, sn);
+                    break;
+                case pad_mode::symmetric:
                 {
-                    XTENSOR_ASSERT(nb <= e.shape(axis));
-                    svs[axis] = xt::range(e.shape(axis), nb + e.shape(axis));
-                    xt::strided_view(out, svt) = xt::strided_view(out, svs);
+                    const std::ptrdiff_t t = positive_mod(q, 2 * sn);
+                    res = t < sn ? t : 2 * sn - 1 - t;
+                    break;
                 }
-                else if (mode == pad_mode::symmetric)
+                case pad_mode::reflect:
                 {
-                    XTENSOR_ASSERT(nb <= e.shape(axis));
-                    svs[axis] = xt::range(2 * nb - 1, nb - 1, -1);
-                    xt::strided_view(out, svt) = xt::strided_view(out, svs);
+                    if (sn > 1)
+                    {
+                        const std::ptrdiff_t t = positive_mod(q, 2 * sn - 2);
+                        res = t < sn ? t : 2 * sn - 2 - t;
+                    }
+                    break;
                 }
-                else if (mode == pad_mode::reflect)
+                default:
+                    res = std::clamp(q, std::ptrdiff_t(0), sn - 1);
+                    break;
+            }
+            return static_cast<std::size_t>(res);
+        }
+
+        // Fills the border slices [first, last) of the axis d, once the
+        // interior slices are written.
+        template <class T>
+        inline void
+        pad_borders(T* dst, const pad_sizes& b, std::size_t d, std::size_t first, std::size_t last, pad_mode mode, T value)
+        {
+            const std::size_t block = b.out.size[d + 1];
+            for (std::size_t k = first; k < last; ++k)
+            {
+                const std::size_t p = k < b.before[d] ? k : k + b.in.shape[d];
+                T* target = dst + p * block;
+                if (mode == pad_mode::constant)
                 {
-                    XTENSOR_ASSERT(nb <= e.shape(axis) - 1);
-                    svs[axis] = xt::range(2 * nb, nb, -1);
-                    xt::strided_view(out, svt) = xt::strided_view(out, svs);
+                    std::fill_n(target, block, value);
                 }
-                else if (mode == pad_mode::edge)
+                else
                 {
-                    svs[axis] = xt::range(nb, nb + 1);
-                    xt::strided_view(out, svt) = xt::broadcast(
-                        xt::strided_view(out, svs),
-                        xt::strided_view(out, svt).shape()
-                    );
+                    const std::size_t s = b.before[d] + pad_source_index(mode, p, b.before[d], b.in.shape[d]);
+                    std::copy(dst + s * block, dst + (s + 1) * block, target);
                 }
             }
+        }
 
-            if (ne > static_cast<size_type>(0))
+        template <class T, class U>
+        inline void pad_blocks_impl(const T* src, U* dst, const pad_sizes& b, std::size_t d, pad_mode mode, U value)
+        {
+            if (d + 1 == b.in.shape.size())
             {
-                svt[axis] = xt::range(out.shape(axis) - ne, out.shape(axis));
-
-                if (mode == pad_mode::wrap || mode == pad_mode::periodic)
+                std::copy(src, src + b.in.shape[d], dst + b.before[d]);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < b.in.shape[d]; ++i)
                 {
-                    XTENSOR_ASSERT(ne <= e.shape(axis));
-                    svs[axis] = xt::range(nb, nb + ne);
-                    xt::strided_view(out, svt) = xt::strided_view(out, svs);
+                    pad_blocks_impl(src + i * b.in.size[d + 1], dst + (b.before[d] + i) * b.out.size[d + 1], b, d + 1, mode, value);
                 }
-                else if (mode == pad_mode::symmetric)
+            }
+            pad_borders(dst, b, d, 0, b.out.shape[d] - b.in.shape[d], mode, value);
+        }
+
+        // Copies the operand into the interior of dst and fills the borders
+        // axis by axis, from the innermost one, with block copies.
+        template <class T, class U>
+        inline void pad_blocks(const T* src, U* dst, const pad_sizes& b, pad_mode mode, U value)
+        {
+            if (b.in.shape.empty())
+            {
+                *dst = static_cast<U>(*src);
+                return;
+            }
+            if (b.in.shape.size() < 2)
+            {
+                pad_blocks_impl(src, dst, b, 0, mode, value);
+                return;
+            }
+            parallel_chunks(
+                b.in.shape[0],
+                b.in.shape[0] * b.out.size[1],
+                [&](std::size_t begin, std::size_t end)
                 {
-                    XTENSOR_ASSERT(ne <= e.shape(axis));
-                    if (ne == nb + e.shape(axis))
-                    {
-                        svs[axis] = xt::range(nb + e.shape(axis) - 1, _, -1);
-                    }
-                    else
+                    for (std::size_t i = begin; i < end; ++i)
                     {
-                        svs[axis] = xt::range(nb + e.shape(axis) - 1, nb + e.shape(axis) - ne - 1, -1);
+                        pad_blocks_impl(src + i * b.in.size[1], dst + (b.before[0] + i) * b.out.size[1], b, 1, mode, value);
                     }
-                    xt::strided_view(out, svt) = xt::strided_view(out, svs);
                 }
-                else if (mode == pad_mode::reflect)
+            );
+            parallel_chunks(
+                b.out.shape[0] - b.in.shape[0],
+                (b.out.shape[0] - b.in.shape[0]) * b.out.size[1],
+                [&](std::size_t begin, std::size_t end)
                 {
-                    XTENSOR_ASSERT(ne <= e.shape(axis) - 1);
-                    if (ne == nb + e.shape(axis) - 1)
-                    {
-                        svs[axis] = xt::range(nb + e.shape(axis) - 2, _, -1);
-                    }
-                    else
+                    pad_borders(dst, b, 0, begin, end, mode, value);
+                }
+            );
+        }
+
+        template <class T, class U>
+        inline void tile_blocks_impl(const T* src, U* dst, const pad_sizes& b, std::size_t d)
+        {
+            if (d + 1 == b.in.shape.size())
+            {
+                std::copy(src, src + b.in.shape[d], dst);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < b.in.shape[d]; ++i)
+                {
+                    tile_blocks_impl(src + i * b.in.size[d + 1], dst + i * b.out.size[d + 1], b, d + 1);
+                }
+            }
+            replicate_block(dst, b.in.shape[d] * b.out.size[d + 1], b.out.shape[d] / b.in.shape[d]);
+        }
+
+        // Writes the first tile of each axis, from the innermost one, and
+        // copies it over the following ones.
+        template <class T, class U>
+        inline void tile_blocks(const T* src, U* dst, const pad_sizes& b)
+        {
+            if (b.in.shape.empty())
+            {
+                *dst = static_cast<U>(*src);
+                return;
+            }
+            if (b.in.shape.size() < 2)
+            {
+                tile_blocks_impl(src, dst, b, 0);
+                return;
+            }
+            parallel_chunks(
+                b.in.shape[0],
+                b.in.shape[0] * b.out.size[1],
+                [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
                     {
-                        svs[axis] = xt::range(nb + e.shape(axis) - 2, nb + e.shape(axis) - ne - 2, -1);
+                        tile_blocks_impl(src + i * b.in.size[1], dst + i * b.out.size[1], b, 1);
                     }
-                    xt::strided_view(out, svt) = xt::strided_view(out, svs);
                 }
-                else if (mode == pad_mode::edge)
+            );
+            const std::size_t block = b.in.shape[0] * b.out.size[1];
+            parallel_chunks(
+                b.out.shape[0] / b.in.shape[0] - 1,
+                (b.out.shape[0] / b.in.shape[0] - 1) * block,
+                [&](std::size_t begin, std::size_t end)
                 {
-                    svs[axis] = xt::range(out.shape(axis) - ne - 1, out.shape(axis) - ne);
-                    xt::strided_view(out, svt) = xt::broadcast(
-                        xt::strided_view(out, svs),
-                        xt::strided_view(out, svt).shape()
-                    );
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        std::copy(dst, dst + block, dst + (i + 1) * block);
+                    }
                 }
-            }
+            );
+        }
+    }
+
+    /**
+     * @brief Pad an array.
+     *
+     * @param e The array.
+     * @param pad_width Number of values padded to the edges of each axis:
+     * `{{before_1, after_1}, ..., {before_N, after_N}}`.
+     * @param mode The type of algorithm to use. [default: `xt::pad_mode::constant`].
+     * @param constant_value The value to set the padded values for each axis
+     * (used in `xt::pad_mode::constant`).
+     * @return The padded array.
+     *
+     * The expression is evaluated once, the borders are then filled axis by axis
+     * with block copies. Pads wider than an axis continue the pattern of the mode,
+     * as ``numpy.pad`` does; only ``constant`` can pad an empty axis.
+     */
+    template <class E, class S = typename std::decay_t<E>::size_type, class V = typename std::decay_t<E>::value_type>
+    inline auto
+    pad(E&& e,
+        const std::vector<std::vector<S>>& pad_width,
+        pad_mode mode = pad_mode::constant,
+        V constant_value = 0)
+    {
+        XTENSOR_ASSERT(detail::check_pad_width(pad_width, e.shape()));
+
+        using size_type = typename std::decay_t<E>::size_type;
+        using return_type = temporary_type_t<E>;
+        using value_type = typename return_type::value_type;
 
-            svs[axis] = xt::all();
-            svt[axis] = xt::all();
+        const std::size_t dim = e.shape().size();
+        auto new_shape = e.shape();
+        std::vector<std::size_t> shape(dim);
+        std::vector<std::size_t> out_shape(dim);
+        std::vector<std::size_t> before(dim);
+        for (std::size_t axis = 0; axis < dim; ++axis)
+        {
+            shape[axis] = static_cast<std::size_t>(e.shape(axis));
+            before[axis] = static_cast<std::size_t>(pad_width[axis][0]);
+            out_shape[axis] = before[axis] + shape[axis] + static_cast<std::size_t>(pad_width[axis][1]);
+            new_shape[axis] = static_cast<size_type>(out_shape[axis]);
+            if (mode != pad_mode::constant && shape[axis] == 0 && out_shape[axis] != 0)
+            {
+                XTENSOR_THROW(std::runtime_error, "pad: cannot extend an empty axis");
+            }
         }
 
+        auto out = detail::make_assign_temporary<return_type>(new_shape);
+        if (out.size() != 0)
+        {
+            const layout_type l = out.layout();
+            detail::contiguous_operand<std::decay_t<E>> src(e, l);
+            const auto sizes = detail::make_pad_sizes(shape, out_shape, before, l);
+            detail::pad_blocks(src.data(), out.data(), sizes, mode, static_cast<value_type>(constant_value));
+        }
         return out;
     }
 
@@ -246,40 +360,30 @@ namespace xt
         inline auto tile(E&& e, const S& reps)
         {
             using size_type = typename std::decay_t<E>::size_type;
-
             using return_type = temporary_type_t<E>;
 
             XTENSOR_ASSERT(e.shape().size() == reps.size());
 
             using new_shape_type = typename return_type::shape_type;
-            auto new_shape = xtl::make_sequence<new_shape_type>(e.shape().size());
-
-            xt::xstrided_slice_vector sv(reps.size());
-
-            for (size_type axis = 0; axis < reps.size(); ++axis)
+            const std::size_t dim = e.shape().size();
+            auto new_shape = xtl::make_sequence<new_shape_type>(dim);
+            std::vector<std::size_t> shape(dim);
+            std::vector<std::size_t> out_shape(dim);
+            for (std::size_t axis = 0; axis < dim; ++axis)
             {
-                new_shape[axis] = e.shape(axis) * reps[axis];
-                sv[axis] = xt::range(0, e.shape(axis));
+                shape[axis] = static_cast<std::size_t>(e.shape(axis));
+                out_shape[axis] = shape[axis] * static_cast<std::size_t>(reps[axis]);
+                new_shape[axis] = static_cast<size_type>(out_shape[axis]);
             }
-            return_type out(new_shape);
-
-            xt::strided_view(out, sv) = e;
-
-            xt::xstrided_slice_vector svs(e.shape().size(), xt::all());
-            xt::xstrided_slice_vector svt(e.shape().size(), xt::all());
 
-            for (size_type axis = 0; axis < e.shape().size(); ++axis)
+            auto out = detail::make_assign_temporary<return_type>(new_shape);
+            if (out.size() != 0)
             {
-                for (size_type i = 1; i < static_cast<size_type>(reps[axis]); ++i)
-                {
-                    svs[axis] = xt::range(0, e.shape(axis));
-                    svt[axis] = xt::range(i * e.shape(axis), (i + 1) * e.shape(axis));
-                    xt::strided_view(out, svt) = xt::strided_view(out, svs);
-                    svs[axis] = xt::all();
-                    svt[axis] = xt::all();
-                }
+                const layout_type l = out.layout();
+                detail::contiguous_operand<std::decay_t<E>> src(e, l);
+                const auto sizes = make_pad_sizes(shape, out_shape, std::vector<std::size_t>(dim, std::size_t(0)), l);
+                tile_blocks(src.data(), out.data(), sizes);
             }
-
             return out;
         }
     }
@@ -11,7 +11,13 @@
 #define XTENSOR_XSET_OPERATION_HPP
 
 #include <algorithm>
+#include <array>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <type_traits>
+#include <unordered_set>
+#include <vector>
 
 #include <xtl/xsequence.hpp>
 
@@ -32,33 +38,149 @@ namespace xt
 
     namespace detail
     {
+        template <class T, class = void>
+        struct isin_is_hashable : std::false_type
+        {
+        };
+
+        template <class T>
+        struct isin_is_hashable<T, std::void_t<decltype(std::hash<T>{}(std::declval<const T&>()))>>
+            : std::true_type
+        {
+        };
+
+        template <class T, class = void>
+        struct isin_is_ordered : std::false_type
+        {
+        };
+
+        template <class T>
+        struct isin_is_ordered<T, std::void_t<decltype(std::declval<const T&>() < std::declval<const T&>())>>
+            : std::true_type
+        {
+        };
+
+        // Test sets up to this size are scanned linearly
+        constexpr std::size_t isin_linear_max = 16;
+
+        // Test sets up to this size are searched by bisection when they cannot be hashed
+        // or when they fit in the cache, larger ones are hashed
+        constexpr std::size_t isin_sorted_max = 1024;
 
-        template <bool lvalue>
-        struct lambda_isin
+        /**
+         * Test elements of isin, built once when the expression is constructed.
+         * Depending on its size and on the operations supported by T, the set
+         * is scanned linearly, searched by bisection or hashed.
+         */
+        template <class T>
+        class isin_set
         {
-            template <class E>
-            static auto make(E&& e)
+        public:
+
+            template <class It>
+            isin_set(It first, It last);
+
+            bool contains(const T& value) const;
+
+        private:
+
+            enum class strategy
             {
-                return [&e](const auto& t)
-                {
-                    return std::find(e.begin(), e.end(), t) != e.end();
-                };
-            }
+                linear,
+                sorted,
+                hashed
+            };
+
+            struct unhashable
+            {
+            };
+
+            using hash_set_type = std::conditional_t<isin_is_hashable<T>::value, std::unordered_set<T>, unhashable>;
+
+            std::vector<T> m_values;
+            hash_set_type m_hashed;
+            strategy m_strategy;
         };
 
-        template <>
-        struct lambda_isin<false>
+        template <class T>
+        template <class It>
+        inline isin_set<T>::isin_set(It first, It last)
+            : m_strategy(strategy::linear)
         {
-            template <class E>
-            static auto make(E&& e)
+            for (; first != last; ++first)
             {
-                return [e](const auto& t)
+                const auto value = static_cast<T>(*first);
+                // values that do not compare equal to themselves (NaN) never match
+                if (value == value)
                 {
-                    return std::find(e.begin(), e.end(), t) != e.end();
-                };
+                    m_values.push_back(value);
+                }
             }
-        };
+            if (m_values.size() <= isin_linear_max)
+            {
+                return;
+            }
+            if constexpr (isin_is_hashable<T>::value)
+            {
+                if (m_values.size() > isin_sorted_max || !isin_is_ordered<T>::value)
+                {
+                    m_hashed.insert(m_values.cbegin(), m_values.cend());
+                    m_values.clear();
+                    m_strategy = strategy::hashed;
+                    return;
+                }
+            }
+            if constexpr (isin_is_ordered<T>::value)
+            {
+                std::sort(m_values.begin(), m_values.end());
+                m_values.erase(std::unique(m_values.begin(), m_values.end()), m_values.end());
+                m_strategy = strategy::sorted;
+            }
+        }
 
+        template <class T>
+        inline bool isin_set<T>::contains(const T& value) const
+        {
+            switch (m_strategy)
+            {
+                case strategy::hashed:
+                    if constexpr (isin_is_hashable<T>::value)
+                    {
+                        return m_hashed.find(value) != m_hashed.cend();
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                case strategy::sorted:
+                    if constexpr (isin_is_ordered<T>::value)
+                    {
+                        return std::binary_search(m_values.cbegin(), m_values.cend(), value);
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                default:
+                    return std::find(m_values.cbegin(), m_values.cend(), value) != m_values.cend();
+            }
+        }
+
+        /**
+         * Returns the function tested on every element by isin. The test elements
+         * are converted to the common type of V and of their value type, the set is
+         * shared by the copies of the function.
+         */
+        template <class V, class It>
+        inline auto make_isin_lambda(It first, It last)
+        {
+            using value_type = std::common_type_t<V, typename std::iterator_traits<std::decay_t<It>>::value_type>;
+            auto set = std::make_shared<const isin_set<value_type>>(first, last);
+            return [set](const auto& t)
+            {
+                return set->contains(static_cast<value_type>(t));
+            };
+        }
     }
 
     /**
@@ -66,18 +188,17 @@ namespace xt
      * @brief isin
      *
      * Returns a boolean array of the same shape as ``element`` that is ``true`` where an element of
-     * ``element`` is in ``test_elements`` and ``False`` otherwise.
+     * ``element`` is in ``test_elements`` and ``False`` otherwise. The test elements are copied
+     * into a hash set or a sorted array when the expression is built.
      * @param element an \ref xexpression
      * @param test_elements an array
      * @return a boolean array
      */
     template <class E, class T>
-    inline auto isin(E&& element, std::initializer_list<T> test_elements) noexcept
+    inline auto isin(E&& element, std::initializer_list<T> test_elements)
     {
-        auto lambda = [test_elements](const auto& t)
-        {
-            return std::find(test_elements.begin(), test_elements.end(), t) != test_elements.end();
-        };
+        using value_type = typename std::decay_t<E>::value_type;
+        auto lambda = detail::make_isin_lambda<value_type>(test_elements.begin(), test_elements.end());
         return make_lambda_xfunction(std::move(lambda), std::forward<E>(element));
     }
 
@@ -86,17 +207,18 @@ namespace xt
      * @brief isin
      *
      * Returns a boolean array of the same shape as ``element`` that is ``true`` where an element of
-     * ``element`` is in ``test_elements`` and ``False`` otherwise.
+     * ``element`` is in ``test_elements`` and ``False`` otherwise. The test elements are copied
+     * into a hash set or a sorted array when the expression is built.
      * @param element an \ref xexpression
      * @param test_elements an array
      * @return a boolean array
      */
     template <class E, class F>
-    inline auto isin(E&& element, F&& test_elements) noexcept
+    inline auto isin(E&& element, F&& test_elements)
         requires(has_iterator_interface_concept<F>)
     {
-        auto lambda = detail::lambda_isin<std::is_lvalue_reference<F>::value>::make(std::forward<F>(test_elements
-        ));
+        using value_type = typename std::decay_t<E>::value_type;
+        auto lambda = detail::make_isin_lambda<value_type>(test_elements.begin(), test_elements.end());
         return make_lambda_xfunction(std::move(lambda), std::forward<E>(element));
     }
 
@@ -105,19 +227,18 @@ namespace xt
      * @brief isin
      *
      * Returns a boolean array of the same shape as ``element`` that is ``true`` where an element of
-     * ``element`` is in ``test_elements`` and ``False`` otherwise.
+     * ``element`` is in ``test_elements`` and ``False`` otherwise. The test elements are copied
+     * into a hash set or a sorted array when the expression is built.
      * @param element an \ref xexpression
      * @param test_elements_begin iterator to the beginning of an array
      * @param test_elements_end iterator to the end of an array
      * @return a boolean array
      */
     template <class E, iterator_concept I>
-    inline auto isin(E&& element, I&& test_elements_begin, I&& test_elements_end) noexcept
+    inline auto isin(E&& element, I&& test_elements_begin, I&& test_elements_end)
     {
-        auto lambda = [&test_elements_begin, &test_elements_end](const auto& t)
-        {
-            return std::find(test_elements_begin, test_elements_end, t) != test_elements_end;
-        };
+        using value_type = typename std::decay_t<E>::value_type;
+        auto lambda = detail::make_isin_lambda<value_type>(test_elements_begin, test_elements_end);
         return make_lambda_xfunction(std::move(lambda), std::forward<E>(element));
     }
 
@@ -132,7 +253,7 @@ namespace xt
      * @return a boolean array
      */
     template <class E, class T>
-    inline auto in1d(E&& element, std::initializer_list<T> test_elements) noexcept
+    inline auto in1d(E&& element, std::initializer_list<T> test_elements)
     {
         XTENSOR_ASSERT(element.dimension() == 1ul);
         return isin(std::forward<E>(element), std::forward<std::initializer_list<T>>(test_elements));
@@ -149,7 +270,7 @@ namespace xt
      * @return a boolean array
      */
     template <class E, class F>
-    inline auto in1d(E&& element, F&& test_elements) noexcept
+    inline auto in1d(E&& element, F&& test_elements)
         requires(has_iterator_interface_concept<F>)
     {
         XTENSOR_ASSERT(element.dimension() == 1ul);
@@ -169,7 +290,7 @@ namespace xt
      * @return a boolean array
      */
     template <class E, iterator_concept I>
-    inline auto in1d(E&& element, I&& test_elements_begin, I&& test_elements_end) noexcept
+    inline auto in1d(E&& element, I&& test_elements_begin, I&& test_elements_end)
     {
         XTENSOR_ASSERT(element.dimension() == 1ul);
         return isin(
@@ -179,10 +300,155 @@ namespace xt
         );
     }
 
+    namespace detail
+    {
+        // Number of queries processed together by the branchless binary search
+        constexpr std::size_t searchsorted_lanes = 8;
+
+        // Number of queries of a task of the parallel searchsorted
+        constexpr std::size_t searchsorted_block = 4096;
+
+        /**
+         * Branchless binary search of the queries q[0], ..., q[count - 1] in the
+         * sorted range [a, a + n), n > 0. The searches of a group of lanes run in
+         * lockstep: they all take the same number of steps, which only depends on
+         * n, so that their loads overlap and the selects are vectorizable.
+         * Left gives the first index i such that !(a[i] < q), like std::lower_bound,
+         * otherwise the first index i such that q < a[i], like std::upper_bound.
+         */
+        template <bool Left, class T, class Q>
+        inline void searchsorted_lanes_search(const T* a, std::size_t n, const Q* q, std::size_t count, std::size_t* out)
+        {
+            auto before = [](const T& x, const Q& y)
+            {
+                if constexpr (Left)
+                {
+                    return x < y;
+                }
+                else
+                {
+                    return !(y < x);
+                }
+            };
+
+            std::size_t i = 0;
+            for (; i + searchsorted_lanes <= count; i += searchsorted_lanes)
+            {
+                std::array<std::size_t, searchsorted_lanes> base = {};
+                std::size_t len = n;
+                while (len > 1)
+                {
+                    const std::size_t half = len / 2;
+                    for (std::size_t k = 0; k < searchsorted_lanes; ++k)
+                    {
+                        base[k] = before(a[base[k] + half], q[i + k]) ? base[k] + half : base[k];
+                    }
+                    len -= half;
+                }
+                for (std::size_t k = 0; k < searchsorted_lanes; ++k)
+                {
+                    out[i + k] = base[k] + (before(a[base[k]], q[i + k]) ? 1u : 0u);
+                }
+            }
+            for (; i < count; ++i)
+            {
+                std::size_t base = 0;
+                std::size_t len = n;
+                while (len > 1)
+                {
+                    const std::size_t half = len / 2;
+                    base = before(a[base + half], q[i]) ? base + half : base;
+                    len -= half;
+                }
+                out[i] = base + (before(a[base], q[i]) ? 1u : 0u);
+            }
+        }
+
+        /**
+         * Search of the sorted queries q[0], ..., q[count - 1] in the sorted range
+         * [a, a + n): the first query is located by binary search, the next ones
+         * by walking forward in a.
+         */
+        template <bool Left, class T, class Q>
+        inline void searchsorted_merge(const T* a, std::size_t n, const Q* q, std::size_t count, std::size_t* out)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+            searchsorted_lanes_search<Left>(a, n, q, 1, out);
+            std::size_t j = out[0];
+            for (std::size_t i = 1; i < count; ++i)
+            {
+                if constexpr (Left)
+                {
+                    while (j < n && a[j] < q[i])
+                    {
+                        ++j;
+                    }
+                }
+                else
+                {
+                    while (j < n && !(q[i] < a[j]))
+                    {
+                        ++j;
+                    }
+                }
+                out[i] = j;
+            }
+        }
+
+        template <bool Left, class T, class Q>
+        inline void searchsorted_imp(const T* a, std::size_t n, const Q* q, std::size_t count, std::size_t* out)
+        {
+            if (n == 0)
+            {
+                std::fill(out, out + count, std::size_t(0));
+                return;
+            }
+            // Walking in a is cheaper than the binary searches when the sorted
+            // queries are dense enough in a
+            const bool merge = n < 8 * count && std::is_sorted(q, q + count);
+            const std::size_t blocks = (count + searchsorted_block - 1) / searchsorted_block;
+            parallel_chunks(
+                blocks,
+                [=](std::size_t first_block, std::size_t last_block)
+                {
+                    const std::size_t first = first_block * searchsorted_block;
+                    const std::size_t last = std::min(last_block * searchsorted_block, count);
+                    if (merge)
+                    {
+                        searchsorted_merge<Left>(a, n, q + first, last - first, out + first);
+                    }
+                    else
+                    {
+                        searchsorted_lanes_search<Left>(a, n, q + first, last - first, out + first);
+                    }
+                }
+            );
+        }
+
+        template <class E>
+        inline bool searchsorted_is_contiguous(const E& a)
+        {
+            if constexpr (has_data_interface<E>::value)
+            {
+                return a.dimension() == 1 && (a.size() <= 1 || a.strides()[0] == 1);
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }
+
     /**
      * @ingroup searchsorted
      * @brief Find indices where elements should be inserted to maintain order.
      *
+     * The queries are searched in parallel blocks, with a branchless binary search or,
+     * when they are sorted and dense in \c a, by a linear merge.
+     *
      * @param a Input array: sorted (array_like).
      * @param v Values to insert into a (array_like).
      * @param right If ``false``, the index of the first suitable location found is given.
@@ -191,25 +457,37 @@ namespace xt
     template <class E1, class E2>
     inline auto searchsorted(E1&& a, E2&& v, bool right = true)
     {
+        using a_value_type = typename std::decay_t<E1>::value_type;
+        using v_value_type = typename std::decay_t<E2>::value_type;
+
         XTENSOR_ASSERT(std::is_sorted(a.cbegin(), a.cend()));
 
         auto out = xt::empty<size_t>(v.shape());
+        const std::vector<v_value_type> queries(v.cbegin(), v.cend());
 
-        if (right)
+        std::vector<a_value_type> a_copy;
+        const a_value_type* a_data = nullptr;
+        if constexpr (has_data_interface<std::decay_t<E1>>::value)
         {
-            for (size_t i = 0; i < v.size(); ++i)
+            if (detail::searchsorted_is_contiguous(a))
             {
-                out(i) = static_cast<std::size_t>(std::lower_bound(a.cbegin(), a.cend(), v(i)) - a.cbegin());
+                a_data = a.data() + a.data_offset();
             }
         }
-        else
+        if (a_data == nullptr)
         {
-            for (size_t i = 0; i < v.size(); ++i)
-            {
-                out(i) = static_cast<std::size_t>(std::upper_bound(a.cbegin(), a.cend(), v(i)) - a.cbegin());
-            }
+            a_copy.assign(a.cbegin(), a.cend());
+            a_data = a_copy.data();
         }
 
+        if (right)
+        {
+            detail::searchsorted_imp<true>(a_data, a.size(), queries.data(), queries.size(), out.data());
+        }
+        else
+        {
+            detail::searchsorted_imp<false>(a_data, a.size(), queries.data(), queries.size(), out.data());
+        }
 
         return out;
     }
@@ -470,7 +470,7 @@ namespace xt
 
         if (ax == detail::leading_axis(de))
         {
-            result_type res = result_type::from_shape(de.shape());
+            result_type res = result_type::from_shape(de.shape(), uninitialized);
             detail::call_over_leading_axis(res, de, argsort);
             return res;
         }
@@ -478,7 +478,7 @@ namespace xt
         dynamic_shape<std::size_t> permutation, reverse_permutation;
         std::tie(permutation, reverse_permutation) = detail::get_permutations(de.dimension(), ax, de.layout());
         eval_type ev = transpose(de, permutation);
-        result_type res = result_type::from_shape(ev.shape());
+        result_type res = result_type::from_shape(ev.shape(), uninitialized);
         detail::call_over_leading_axis(res, ev, argsort);
         res = transpose(res, reverse_permutation);
         return res;
@@ -566,7 +566,7 @@ namespace xt
     {
         const auto& de = e.derived_cast();
 
-        R ev = R::from_shape({de.size()});
+        R ev = R::from_shape({de.size()}, uninitialized);
         std::sort(kth_container.begin(), kth_container.end());
 
         std::copy(de.linear_cbegin(), de.linear_cend(), ev.linear_begin());  // flatten
@@ -663,7 +663,7 @@ namespace xt
 
         const auto& de = e.derived_cast();
 
-        result_type res = result_type::from_shape({de.size()});
+        result_type res = result_type::from_shape({de.size()}, uninitialized);
 
         std::sort(kth_container.begin(), kth_container.end());
 
@@ -732,7 +732,7 @@ namespace xt
         const std::size_t ax = normalize_axis(de.dimension(), axis);
         if (ax == detail::leading_axis(de))
         {
-            result_type res = result_type::from_shape(de.shape());
+            result_type res = result_type::from_shape(de.shape(), uninitialized);
             detail::call_over_leading_axis(res, de, argpartition_w_kth);
             return res;
         }
@@ -740,7 +740,7 @@ namespace xt
         dynamic_shape<std::size_t> permutation, reverse_permutation;
         std::tie(permutation, reverse_permutation) = detail::get_permutations(de.dimension(), ax, de.layout());
         eval_type ev = transpose(de, permutation);
-        result_type res = result_type::from_shape(ev.shape());
+        result_type res = result_type::from_shape(ev.shape(), uninitialized);
         detail::call_over_leading_axis(res, ev, argpartition_w_kth);
         res = transpose(res, reverse_permutation);
         return res;
@@ -1192,7 +1192,7 @@ namespace xt
                 alt_shape.begin() + std::ptrdiff_t(axis)
             );
 
-            result_type result = result_type::from_shape(std::move(alt_shape));
+            result_type result = result_type::from_shape(std::move(alt_shape), uninitialized);
             auto result_iter = result.template begin<L>();
 
             auto arg_func_lambda = [&result_iter, &cmp](auto begin, auto end)
@@ -1310,7 +1310,7 @@ namespace xt
         std::size_t sz = static_cast<std::size_t>(std::distance(sorted.begin(), end));
         // TODO check if we can shrink the vector without reallocation
         using value_type = typename E::value_type;
-        auto result = xtensor<value_type, 1>::from_shape({sz});
+        auto result = xtensor<value_type, 1>::from_shape({sz}, uninitialized);
         std::copy(sorted.begin(), end, result.begin());
         return result;
     }
@@ -1331,13 +1331,13 @@ namespace xt
         auto unique1 = unique(ar1);
         auto unique2 = unique(ar2);
 
-        auto tmp = xtensor<value_type, 1>::from_shape({unique1.size()});
+        auto tmp = xtensor<value_type, 1>::from_shape({unique1.size()}, uninitialized);
 
         auto end = std::set_difference(unique1.begin(), unique1.end(), unique2.begin(), unique2.end(), tmp.begin());
 
         std::size_t sz = static_cast<std::size_t>(std::distance(tmp.begin(), end));
 
-        auto result = xtensor<value_type, 1>::from_shape({sz});
+        auto result = xtensor<value_type, 1>::from_shape({sz}, uninitialized);
 
         std::copy(tmp.begin(), end, result.begin());
 
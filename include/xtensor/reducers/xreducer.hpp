@@ -28,6 +28,7 @@
 #include "../core/xtensor_config.hpp"
 #include "../generators/xbuilder.hpp"
 #include "../generators/xgenerator.hpp"
+#include "../utils/xinstrumentation.hpp"
 #include "../utils/xutils.hpp"
 
 namespace xt
@@ -300,6 +301,13 @@ namespace xt
         using options_t = reducer_options<result_type, std::decay_t<O>>;
         options_t options(raw_options);
 
+        XTENSOR_INSTRUMENT(instrumentation::scoped_event event(
+                               instrumentation::event_kind::reduction,
+                               "reduce_immediate",
+                               e.size(),
+                               e.size() * sizeof(expr_value_type)
+        );)
+
         using shape_type = typename xreducer_shape_type<
             typename std::decay_t<E>::shape_type,
             std::decay_t<X>,
@@ -0,0 +1,729 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay and Wolf Vollprecht          *
+ * Copyright (c) QuantStack                                                 *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XTENSOR_ALLOCATOR_HPP
+#define XTENSOR_ALLOCATOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../core/xtensor_config.hpp"
+
+#if defined(XTENSOR_USE_TBB)
+#include <tbb/tbb.h>
+#endif
+
+#ifndef XTENSOR_HUGE_PAGE_SIZE
+#define XTENSOR_HUGE_PAGE_SIZE (std::size_t(2) << 20)
+#endif
+
+#ifndef XTENSOR_HUGE_PAGE_THRESHOLD
+#define XTENSOR_HUGE_PAGE_THRESHOLD XTENSOR_HUGE_PAGE_SIZE
+#endif
+
+#ifndef XTENSOR_STORAGE_POOL_MAX_CACHED
+#define XTENSOR_STORAGE_POOL_MAX_CACHED (std::size_t(256) << 20)
+#endif
+
+namespace xt
+{
+    /***********************
+     * huge page settings  *
+     ***********************/
+
+    namespace huge_page
+    {
+        /**
+         * NUMA placement applied to the pages of large allocations.
+         *
+         * - ``local``: default kernel policy, pages are placed on the node
+         *   of the thread that first touches them.
+         * - ``interleave``: pages are distributed round-robin over the nodes
+         *   of the node mask.
+         * - ``bind``: pages are restricted to the nodes of the node mask.
+         */
+        enum class numa_policy
+        {
+            local,
+            interleave,
+            bind
+        };
+
+        struct settings_type
+        {
+            numa_policy policy = numa_policy::local;
+            // Bit i set means NUMA node i is eligible; 0 means all nodes.
+            std::uint64_t node_mask = 0;
+            // Request transparent huge pages with madvise.
+            bool transparent = true;
+        };
+
+        inline settings_type& settings()
+        {
+            static settings_type s;
+            return s;
+        }
+
+        inline void set_numa_policy(numa_policy policy, std::uint64_t node_mask = 0)
+        {
+            settings().policy = policy;
+            settings().node_mask = node_mask;
+        }
+
+        inline void enable_transparent_huge_pages(bool enable = true)
+        {
+            settings().transparent = enable;
+        }
+
+        namespace detail
+        {
+            [[noreturn]] inline void throw_bad_alloc()
+            {
+#if defined(XTENSOR_DISABLE_EXCEPTIONS)
+                std::abort();
+#else
+                throw std::bad_alloc();
+#endif
+            }
+
+            constexpr std::size_t round_to_page(std::size_t nbytes) noexcept
+            {
+                return (nbytes + XTENSOR_HUGE_PAGE_SIZE - 1) & ~(XTENSOR_HUGE_PAGE_SIZE - 1);
+            }
+
+#if defined(__linux__)
+            // Values from linux/mempolicy.h, redefined to avoid a dependency on libnuma.
+            constexpr int mpol_bind = 2;
+            constexpr int mpol_interleave = 3;
+
+            inline void apply_numa_policy(void* ptr, std::size_t nbytes, const settings_type& s) noexcept
+            {
+#if defined(SYS_mbind)
+                if (s.policy == numa_policy::local)
+                {
+                    return;
+                }
+                unsigned long mask = s.node_mask != 0 ? static_cast<unsigned long>(s.node_mask)
+                                                      : ~0UL;
+                int mode = s.policy == numa_policy::bind ? mpol_bind : mpol_interleave;
+                // The kernel ignores the failure of a best-effort placement request,
+                // so do we: the memory remains usable with the default policy.
+                syscall(SYS_mbind, ptr, nbytes, mode, &mask, sizeof(unsigned long) * 8 + 1, 0);
+#else
+                (void) ptr;
+                (void) nbytes;
+                (void) s;
+#endif
+            }
+
+            inline void* map_pages(std::size_t nbytes)
+            {
+                std::size_t mapped = round_to_page(nbytes);
+                void* ptr = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (ptr == MAP_FAILED)
+                {
+                    throw_bad_alloc();
+                }
+                const settings_type& s = settings();
+#if defined(MADV_HUGEPAGE)
+                if (s.transparent)
+                {
+                    madvise(ptr, mapped, MADV_HUGEPAGE);
+                }
+#endif
+                apply_numa_policy(ptr, mapped, s);
+                return ptr;
+            }
+
+            inline void unmap_pages(void* ptr, std::size_t nbytes) noexcept
+            {
+                munmap(ptr, round_to_page(nbytes));
+            }
+#else
+            inline void* map_pages(std::size_t nbytes)
+            {
+                return ::operator new(round_to_page(nbytes), std::align_val_t(XTENSOR_HUGE_PAGE_SIZE));
+            }
+
+            inline void unmap_pages(void* ptr, std::size_t /*nbytes*/) noexcept
+            {
+                ::operator delete(ptr, std::align_val_t(XTENSOR_HUGE_PAGE_SIZE));
+            }
+#endif
+        }
+    }
+
+    /***********************
+     * huge_page_allocator *
+     ***********************/
+
+    /**
+     * @class huge_page_allocator
+     * @brief Allocator for very large containers.
+     *
+     * Allocations of at least ``XTENSOR_HUGE_PAGE_THRESHOLD`` bytes are
+     * mapped directly from the system, rounded up to a multiple of
+     * ``XTENSOR_HUGE_PAGE_SIZE``, advised for transparent huge pages and
+     * placed according to the NUMA policy of ``huge_page::settings()``.
+     * Smaller allocations are served by the aligned global operator new,
+     * with the alignment \c A (0 means the natural alignment of \c T).
+     *
+     * The allocator does not touch the memory; combine it with first_touch
+     * so that the pages are faulted in by the threads that later compute
+     * on them.
+     *
+     * Defining ``XTENSOR_USE_HUGE_PAGES`` makes it the default allocator
+     * of xtensor containers.
+     *
+     * @tparam T the type of the allocated elements.
+     * @tparam A the alignment of small allocations.
+     */
+    template <class T, std::size_t A = XTENSOR_DEFAULT_ALIGNMENT>
+    class huge_page_allocator
+    {
+    public:
+
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using reference = T&;
+        using const_reference = const T&;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        using propagate_on_container_move_assignment = std::true_type;
+        using is_always_equal = std::true_type;
+
+        static constexpr std::size_t alignment = A != 0 ? (std::max)(A, alignof(T)) : alignof(T);
+
+        template <class U>
+        struct rebind
+        {
+            using other = huge_page_allocator<U, A>;
+        };
+
+        huge_page_allocator() noexcept = default;
+
+        template <class U>
+        huge_page_allocator(const huge_page_allocator<U, A>&) noexcept
+        {
+        }
+
+        pointer allocate(size_type n);
+        void deallocate(pointer p, size_type n) noexcept;
+
+        size_type max_size() const noexcept;
+
+        static constexpr bool uses_huge_pages(size_type n) noexcept;
+    };
+
+    template <class T1, std::size_t A1, class T2, std::size_t A2>
+    bool operator==(const huge_page_allocator<T1, A1>&, const huge_page_allocator<T2, A2>&) noexcept;
+
+    template <class T1, std::size_t A1, class T2, std::size_t A2>
+    bool operator!=(const huge_page_allocator<T1, A1>&, const huge_page_allocator<T2, A2>&) noexcept;
+
+    /*************************
+     * storage pool settings *
+     *************************/
+
+    namespace storage_pool
+    {
+        /**
+         * Per-thread counters of the storage pool.
+         *
+         * - ``hits``: allocations served from a cached block.
+         * - ``misses``: allocations that reached the global operator new.
+         * - ``recycled``: deallocations whose block was kept for reuse.
+         * - ``released``: deallocations whose block was returned to the system.
+         */
+        struct statistics
+        {
+            std::size_t hits = 0;
+            std::size_t misses = 0;
+            std::size_t recycled = 0;
+            std::size_t released = 0;
+        };
+
+        statistics& stats() noexcept;
+        void reset_stats() noexcept;
+
+        std::size_t cached_bytes() noexcept;
+        void set_max_cached_bytes(std::size_t nbytes) noexcept;
+        void clear() noexcept;
+
+        namespace detail
+        {
+            // Blocks are aligned on a cache line so that they can be shared
+            // between value types and SIMD architectures.
+            constexpr std::size_t block_alignment = 64;
+            constexpr std::size_t min_block_size = 64;
+            // min_block_size is 2^6, the largest class is 2^(bits - 1) bytes
+            constexpr std::size_t size_class_count = sizeof(std::size_t) * 8 - 6;
+
+            std::size_t size_class(std::size_t nbytes) noexcept;
+            constexpr std::size_t class_size(std::size_t size_class) noexcept;
+            constexpr bool is_cacheable(std::size_t size_class) noexcept;
+
+            void* acquire(std::size_t nbytes);
+            void recycle(void* ptr, std::size_t nbytes) noexcept;
+        }
+    }
+
+    /******************
+     * pool_allocator *
+     ******************/
+
+    /**
+     * @class pool_allocator
+     * @brief Allocator recycling the blocks of short-lived containers.
+     *
+     * Deallocated blocks are kept in thread-local free lists, one per
+     * power-of-two size class, and handed back to the next allocation of the
+     * same size class on the same thread. A loop that repeatedly creates
+     * temporaries of the same shape therefore reaches a steady state without
+     * any call to the global allocator. The cache of a thread is bounded by
+     * ``storage_pool::set_max_cached_bytes`` and released when the thread
+     * exits or on ``storage_pool::clear``.
+     *
+     * Defining ``XTENSOR_USE_STORAGE_POOL`` makes it the default allocator
+     * of xtensor containers.
+     *
+     * @tparam T the type of the allocated elements.
+     */
+    template <class T>
+    class pool_allocator
+    {
+    public:
+
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using reference = T&;
+        using const_reference = const T&;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        using propagate_on_container_move_assignment = std::true_type;
+        using is_always_equal = std::true_type;
+
+        static_assert(
+            alignof(T) <= storage_pool::detail::block_alignment,
+            "pool_allocator does not support over-aligned types"
+        );
+
+        template <class U>
+        struct rebind
+        {
+            using other = pool_allocator<U>;
+        };
+
+        pool_allocator() noexcept = default;
+
+        template <class U>
+        pool_allocator(const pool_allocator<U>&) noexcept
+        {
+        }
+
+        pointer allocate(size_type n);
+        void deallocate(pointer p, size_type n) noexcept;
+
+        size_type max_size() const noexcept;
+    };
+
+    template <class T1, class T2>
+    bool operator==(const pool_allocator<T1>&, const pool_allocator<T2>&) noexcept;
+
+    template <class T1, class T2>
+    bool operator!=(const pool_allocator<T1>&, const pool_allocator<T2>&) noexcept;
+
+    /***************
+     * first_touch *
+     ***************/
+
+    template <class C>
+    void first_touch(C& c);
+
+    /**************************************
+     * huge_page_allocator implementation *
+     **************************************/
+
+    /**
+     * Returns true if an allocation of \c n elements is mapped with huge pages.
+     */
+    template <class T, std::size_t A>
+    constexpr bool huge_page_allocator<T, A>::uses_huge_pages(size_type n) noexcept
+    {
+        return n * sizeof(T) >= XTENSOR_HUGE_PAGE_THRESHOLD;
+    }
+
+    template <class T, std::size_t A>
+    inline auto huge_page_allocator<T, A>::allocate(size_type n) -> pointer
+    {
+        if (n > max_size())
+        {
+            huge_page::detail::throw_bad_alloc();
+        }
+        if (uses_huge_pages(n))
+        {
+            return static_cast<pointer>(huge_page::detail::map_pages(n * sizeof(T)));
+        }
+        return static_cast<pointer>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+    }
+
+    template <class T, std::size_t A>
+    inline void huge_page_allocator<T, A>::deallocate(pointer p, size_type n) noexcept
+    {
+        if (p == nullptr)
+        {
+            return;
+        }
+        if (uses_huge_pages(n))
+        {
+            huge_page::detail::unmap_pages(p, n * sizeof(T));
+        }
+        else
+        {
+            ::operator delete(p, std::align_val_t(alignment));
+        }
+    }
+
+    template <class T, std::size_t A>
+    inline auto huge_page_allocator<T, A>::max_size() const noexcept -> size_type
+    {
+        return (std::numeric_limits<size_type>::max)() / sizeof(T);
+    }
+
+    template <class T1, std::size_t A1, class T2, std::size_t A2>
+    inline bool operator==(const huge_page_allocator<T1, A1>&, const huge_page_allocator<T2, A2>&) noexcept
+    {
+        return A1 == A2;
+    }
+
+    template <class T1, std::size_t A1, class T2, std::size_t A2>
+    inline bool operator!=(const huge_page_allocator<T1, A1>& lhs, const huge_page_allocator<T2, A2>& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    /*******************************
+     * storage_pool implementation *
+     *******************************/
+
+    namespace storage_pool
+    {
+        namespace detail
+        {
+            struct free_lists
+            {
+                free_lists() = default;
+                free_lists(const free_lists&) = delete;
+                free_lists& operator=(const free_lists&) = delete;
+                ~free_lists();
+
+                void release_all() noexcept;
+
+                std::array<std::vector<void*>, size_class_count> lists;
+                std::size_t cached_bytes = 0;
+                std::size_t max_cached_bytes = XTENSOR_STORAGE_POOL_MAX_CACHED;
+                statistics stats;
+            };
+
+            // Trivially destructible, hence still readable by containers
+            // destroyed after the free lists of the exiting thread.
+            inline thread_local bool pool_destroyed = false;
+
+            inline free_lists& local_free_lists() noexcept
+            {
+                thread_local free_lists fl;
+                return fl;
+            }
+
+            inline void free_block(void* ptr) noexcept
+            {
+                ::operator delete(ptr, std::align_val_t(block_alignment));
+            }
+
+            inline free_lists::~free_lists()
+            {
+                release_all();
+                pool_destroyed = true;
+            }
+
+            inline void free_lists::release_all() noexcept
+            {
+                for (auto& l : lists)
+                {
+                    for (void* ptr : l)
+                    {
+                        free_block(ptr);
+                    }
+                    l.clear();
+                }
+                cached_bytes = 0;
+            }
+
+            inline std::size_t size_class(std::size_t nbytes) noexcept
+            {
+                std::size_t cls = 0;
+                std::size_t size = min_block_size;
+                while (size < nbytes && cls + 1 < size_class_count)
+                {
+                    size <<= 1;
+                    ++cls;
+                }
+                return cls;
+            }
+
+            constexpr std::size_t class_size(std::size_t size_class) noexcept
+            {
+                return min_block_size << size_class;
+            }
+
+            // Blocks of larger classes can never be cached, they are allocated
+            // with their exact size instead of being rounded up to the class size.
+            constexpr bool is_cacheable(std::size_t size_class) noexcept
+            {
+                return class_size(size_class) <= XTENSOR_STORAGE_POOL_MAX_CACHED;
+            }
+
+            inline void* acquire(std::size_t nbytes)
+            {
+                std::size_t cls = size_class(nbytes);
+                if (!is_cacheable(cls))
+                {
+                    if (!pool_destroyed)
+                    {
+                        ++local_free_lists().stats.misses;
+                    }
+                    return ::operator new(nbytes, std::align_val_t(block_alignment));
+                }
+                if (!pool_destroyed)
+                {
+                    free_lists& fl = local_free_lists();
+                    auto& l = fl.lists[cls];
+                    if (!l.empty())
+                    {
+                        void* ptr = l.back();
+                        l.pop_back();
+                        fl.cached_bytes -= class_size(cls);
+                        ++fl.stats.hits;
+                        return ptr;
+                    }
+                    ++fl.stats.misses;
+                }
+                return ::operator new(class_size(cls), std::align_val_t(block_alignment));
+            }
+
+            inline void recycle(void* ptr, std::size_t nbytes) noexcept
+            {
+                std::size_t cls = size_class(nbytes);
+                if (!pool_destroyed)
+                {
+                    free_lists& fl = local_free_lists();
+                    if (is_cacheable(cls) && fl.cached_bytes + class_size(cls) <= fl.max_cached_bytes)
+                    {
+#if defined(XTENSOR_DISABLE_EXCEPTIONS)
+                        fl.lists[cls].push_back(ptr);
+                        fl.cached_bytes += class_size(cls);
+                        ++fl.stats.recycled;
+                        return;
+#else
+                        try
+                        {
+                            fl.lists[cls].push_back(ptr);
+                            fl.cached_bytes += class_size(cls);
+                            ++fl.stats.recycled;
+                            return;
+                        }
+                        catch (...)
+                        {
+                            // The free list could not grow, release the block instead
+                        }
+#endif
+                    }
+                    ++fl.stats.released;
+                }
+                free_block(ptr);
+            }
+        }
+
+        /**
+         * Returns the counters of the calling thread.
+         */
+        inline statistics& stats() noexcept
+        {
+            return detail::local_free_lists().stats;
+        }
+
+        /**
+         * Resets the counters of the calling thread.
+         */
+        inline void reset_stats() noexcept
+        {
+            stats() = statistics();
+        }
+
+        /**
+         * Returns the number of bytes cached by the calling thread.
+         */
+        inline std::size_t cached_bytes() noexcept
+        {
+            return detail::local_free_lists().cached_bytes;
+        }
+
+        /**
+         * Sets the maximum number of bytes cached by the calling thread.
+         * Blocks that would exceed it are returned to the system upon
+         * deallocation. The default is ``XTENSOR_STORAGE_POOL_MAX_CACHED``,
+         * blocks whose size class exceeds ``XTENSOR_STORAGE_POOL_MAX_CACHED``
+         * are never cached whatever this limit.
+         */
+        inline void set_max_cached_bytes(std::size_t nbytes) noexcept
+        {
+            detail::local_free_lists().max_cached_bytes = nbytes;
+        }
+
+        /**
+         * Returns all the blocks cached by the calling thread to the system.
+         */
+        inline void clear() noexcept
+        {
+            detail::local_free_lists().release_all();
+        }
+    }
+
+    /*********************************
+     * pool_allocator implementation *
+     *********************************/
+
+    template <class T>
+    inline auto pool_allocator<T>::allocate(size_type n) -> pointer
+    {
+        if (n > max_size())
+        {
+            huge_page::detail::throw_bad_alloc();
+        }
+        return static_cast<pointer>(storage_pool::detail::acquire(n * sizeof(T)));
+    }
+
+    template <class T>
+    inline void pool_allocator<T>::deallocate(pointer p, size_type n) noexcept
+    {
+        if (p != nullptr)
+        {
+            storage_pool::detail::recycle(p, n * sizeof(T));
+        }
+    }
+
+    template <class T>
+    inline auto pool_allocator<T>::max_size() const noexcept -> size_type
+    {
+        return storage_pool::detail::class_size(storage_pool::detail::size_class_count - 1) / sizeof(T);
+    }
+
+    template <class T1, class T2>
+    inline bool operator==(const pool_allocator<T1>&, const pool_allocator<T2>&) noexcept
+    {
+        return true;
+    }
+
+    template <class T1, class T2>
+    inline bool operator!=(const pool_allocator<T1>& lhs, const pool_allocator<T2>& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    /******************************
+     * first_touch implementation *
+     ******************************/
+
+    /**
+     * Value-initializes the elements of a contiguous container with the
+     * same static partitioning as the parallel linear assigner.
+     *
+     * On NUMA systems with the default (local) policy, a page is placed
+     * on the node of the thread that first writes it. Calling this function
+     * right after the creation of an uninitialized container ensures that
+     * the threads running subsequent parallel assignments find their part
+     * of the data in local memory. Without TBB or OpenMP support this is a
+     * sequential fill.
+     *
+     * @param c the container to initialize.
+     */
+    template <class C>
+    inline void first_touch(C& c)
+    {
+        using value_type = typename C::value_type;
+        auto* first = c.data();
+        std::ptrdiff_t n = static_cast<std::ptrdiff_t>(c.size());
+#if defined(XTENSOR_USE_TBB)
+        if (static_cast<std::size_t>(n) >= XTENSOR_TBB_THRESHOLD)
+        {
+            tbb::static_partitioner sp;
+            tbb::parallel_for(
+                tbb::blocked_range<std::ptrdiff_t>(0, n),
+                [first](const tbb::blocked_range<std::ptrdiff_t>& r)
+                {
+                    std::fill(first + r.begin(), first + r.end(), value_type());
+                },
+                sp
+            );
+            return;
+        }
+#elif defined(XTENSOR_USE_OPENMP)
+        if (static_cast<std::size_t>(n) >= XTENSOR_OPENMP_TRESHOLD)
+        {
+#pragma omp parallel for schedule(static) default(none) shared(first, n)
+            for (std::ptrdiff_t i = 0; i < n; ++i)
+            {
+                first[i] = value_type();
+            }
+            return;
+        }
+#endif
+        std::fill(first, first + n, value_type());
+    }
+}
+
+#if defined(XTENSOR_USE_XSIMD)
+namespace xsimd
+{
+    template <class T, std::size_t A>
+    struct allocator_alignment<xt::huge_page_allocator<T, A>>
+    {
+        using type = std::conditional_t<(A != 0 && A >= XSIMD_DEFAULT_ALIGNMENT), aligned_mode, unaligned_mode>;
+    };
+
+    template <class T>
+    struct allocator_alignment<xt::pool_allocator<T>>
+    {
+        using type = std::conditional_t<
+            (xt::storage_pool::detail::block_alignment >= XSIMD_DEFAULT_ALIGNMENT),
+            aligned_mode,
+            unaligned_mode>;
+    };
+}
+#endif
+
+#endif
@@ -0,0 +1,256 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay and Wolf Vollprecht          *
+ * Copyright (c) QuantStack                                                 *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#ifndef XTENSOR_INSTRUMENTATION_HPP
+#define XTENSOR_INSTRUMENTATION_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#include "../core/xtensor_config.hpp"
+
+/**
+ * Expands to its arguments when ``XTENSOR_INSTRUMENTATION`` is defined and
+ * to nothing otherwise, so that the instrumentation points of the library
+ * have no cost in regular builds.
+ */
+#if defined(XTENSOR_INSTRUMENTATION)
+#define XTENSOR_INSTRUMENT(...) __VA_ARGS__
+#else
+#define XTENSOR_INSTRUMENT(...)
+#endif
+
+namespace xt
+{
+    namespace instrumentation
+    {
+        /*********
+         * event *
+         *********/
+
+        enum class event_kind
+        {
+            allocation,
+            deallocation,
+            resize,
+            assignment,
+            reduction
+        };
+
+        /**
+         * Loop selected by the assignment of an expression:
+         * - ``linear``: single loop over contiguous storages (possibly SIMD),
+         * - ``strided``: SIMD inner loop over the contiguous part of strided storages,
+         * - ``transpose``: tiled copy of an operand contiguous along another dimension,
+         * - ``stepper``: generic multi-index traversal.
+         */
+        enum class assigner_path
+        {
+            none,
+            linear,
+            strided,
+            transpose,
+            stepper
+        };
+
+        struct event
+        {
+            event_kind kind;
+            const char* name;
+            assigner_path path = assigner_path::none;
+            std::size_t elements = 0;
+            std::size_t bytes = 0;
+            std::chrono::nanoseconds elapsed = std::chrono::nanoseconds(0);
+        };
+
+        const char* to_string(event_kind kind) noexcept;
+        const char* to_string(assigner_path path) noexcept;
+
+        /************
+         * callback *
+         ************/
+
+        using callback_type = std::function<void(const event&)>;
+
+        void set_callback(callback_type cb);
+        void clear_callback();
+        bool has_callback() noexcept;
+
+        void notify(const event& e);
+
+        /****************
+         * scoped_event *
+         ****************/
+
+        /**
+         * Measures the lifetime of a scope and reports it to the installed
+         * callback upon destruction. Nothing is measured when no callback
+         * is installed at construction.
+         */
+        class scoped_event
+        {
+        public:
+
+            using clock_type = std::chrono::steady_clock;
+
+            scoped_event(event_kind kind, const char* name, std::size_t elements = 0, std::size_t bytes = 0);
+            ~scoped_event();
+
+            scoped_event(const scoped_event&) = delete;
+            scoped_event& operator=(const scoped_event&) = delete;
+
+            void set_path(assigner_path path) noexcept;
+            void set_size(std::size_t elements, std::size_t bytes) noexcept;
+
+        private:
+
+            event m_event;
+            clock_type::time_point m_start;
+            bool m_active;
+        };
+
+        /**********************************
+         * instrumentation implementation *
+         **********************************/
+
+        namespace detail
+        {
+            inline callback_type& callback()
+            {
+                static callback_type cb;
+                return cb;
+            }
+
+            // Containers created by the callback itself must not be reported
+            inline bool& in_callback() noexcept
+            {
+                thread_local bool flag = false;
+                return flag;
+            }
+        }
+
+        inline const char* to_string(event_kind kind) noexcept
+        {
+            switch (kind)
+            {
+                case event_kind::allocation:
+                    return "allocation";
+                case event_kind::deallocation:
+                    return "deallocation";
+                case event_kind::resize:
+                    return "resize";
+                case event_kind::assignment:
+                    return "assignment";
+                case event_kind::reduction:
+                    return "reduction";
+            }
+            return "";
+        }
+
+        inline const char* to_string(assigner_path path) noexcept
+        {
+            switch (path)
+            {
+                case assigner_path::none:
+                    return "none";
+                case assigner_path::linear:
+                    return "linear";
+                case assigner_path::strided:
+                    return "strided";
+                case assigner_path::transpose:
+                    return "transpose";
+                case assigner_path::stepper:
+                    return "stepper";
+            }
+            return "";
+        }
+
+        /**
+         * Installs the function called for every instrumented event.
+         * The callback is global and not synchronized: install it before
+         * computations start. Events are only emitted when the library is
+         * built with ``XTENSOR_INSTRUMENTATION`` defined.
+         */
+        inline void set_callback(callback_type cb)
+        {
+            detail::callback() = std::move(cb);
+        }
+
+        inline void clear_callback()
+        {
+            detail::callback() = nullptr;
+        }
+
+        inline bool has_callback() noexcept
+        {
+            return static_cast<bool>(detail::callback()) && !detail::in_callback();
+        }
+
+        inline void notify(const event& e)
+        {
+            if (has_callback())
+            {
+                detail::in_callback() = true;
+                struct reset_guard
+                {
+                    ~reset_guard()
+                    {
+                        detail::in_callback() = false;
+                    }
+                } guard;
+                detail::callback()(e);
+            }
+        }
+
+        inline scoped_event::scoped_event(event_kind kind, const char* name, std::size_t elements, std::size_t bytes)
+            : m_event{kind, name, assigner_path::none, elements, bytes}
+            , m_active(has_callback())
+        {
+            if (m_active)
+            {
+                m_start = clock_type::now();
+            }
+        }
+
+        inline scoped_event::~scoped_event()
+        {
+            if (m_active)
+            {
+                m_event.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - m_start);
+#if defined(XTENSOR_DISABLE_EXCEPTIONS)
+                notify(m_event);
+#else
+                try
+                {
+                    notify(m_event);
+                }
+                catch (...)
+                {
+                    // Destructors must not throw, the event is dropped
+                }
+#endif
+            }
+        }
+
+        inline void scoped_event::set_path(assigner_path path) noexcept
+        {
+            m_event.path = path;
+        }
+
+        inline void scoped_event::set_size(std::size_t elements, std::size_t bytes) noexcept
+        {
+            m_event.elements = elements;
+            m_event.bytes = bytes;
+        }
+    }
+}
+
+#endif
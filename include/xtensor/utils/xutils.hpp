@@ -27,6 +27,13 @@
 #include <xtl/xtype_traits.hpp>
 
 #include "../core/xtensor_config.hpp"
+#include "../utils/xexception.hpp"
+
+#if defined(XTENSOR_USE_TBB)
+#include <tbb/tbb.h>
+#elif defined(XTENSOR_USE_OPENMP)
+#include <omp.h>
+#endif
 
 namespace xt
 {
@@ -67,6 +74,14 @@ namespace xt
     template <std::size_t... I>
     bool resize_container(fixed_shape<I...>& a, std::size_t size);
 
+    struct uninitialized_t;
+
+    template <class C>
+    bool resize_container(C& c, typename C::size_type size, uninitialized_t);
+
+    template <class C, class S>
+    C uninitialized_from_shape(S&& shape);
+
     template <class X, class C>
     struct rebind_container;
 
@@ -101,6 +116,58 @@ namespace xt
     template <class T, class R>
     using disable_integral_t = std::enable_if_t<!xtl::is_integral<T>::value, R>;
 
+    /****************************
+     * uninitialized definition *
+     ****************************/
+
+    /**
+     * Tag type selecting the constructors and resize overloads that do
+     * not initialize the elements of a container. The content of the
+     * container is indeterminate until it is written; use it when every
+     * element is assigned right after the allocation.
+     */
+    struct uninitialized_t
+    {
+        explicit uninitialized_t() = default;
+    };
+
+    inline constexpr uninitialized_t uninitialized{};
+
+    /**
+     * Types whose objects can be left unconstructed in allocated storage
+     * and brought to life by assignment. For other types, the uninitialized
+     * overloads value-initialize the elements.
+     */
+    template <class T>
+    struct is_uninitialized_safe
+        : std::conjunction<std::is_trivially_copyable<T>, std::is_trivially_destructible<T>>
+    {
+    };
+
+    template <class C, class = void>
+    struct has_uninitialized_resize : std::false_type
+    {
+    };
+
+    template <class C>
+    struct has_uninitialized_resize<
+        C,
+        void_t<decltype(std::declval<C&>().resize(std::declval<typename C::size_type>(), uninitialized))>>
+        : std::true_type
+    {
+    };
+
+    template <class C, class S, class = void>
+    struct has_uninitialized_from_shape : std::false_type
+    {
+    };
+
+    template <class C, class S>
+    struct has_uninitialized_from_shape<C, S, void_t<decltype(C::from_shape(std::declval<S>(), uninitialized))>>
+        : std::true_type
+    {
+    };
+
     /********************************
      * meta identity implementation *
      ********************************/
@@ -345,6 +412,38 @@ namespace xt
         return sizeof...(I) == size;
     }
 
+    template <class C>
+    inline bool resize_container(C& c, typename C::size_type size, uninitialized_t)
+    {
+        if constexpr (has_uninitialized_resize<C>::value)
+        {
+            c.resize(size, uninitialized);
+            return true;
+        }
+        else
+        {
+            return resize_container(c, size);
+        }
+    }
+
+    /**
+     * Returns a container of type \c C with the given shape, built with
+     * ``C::from_shape(shape, uninitialized)`` when \c C provides it and with
+     * ``C::from_shape(shape)`` otherwise.
+     */
+    template <class C, class S>
+    inline C uninitialized_from_shape(S&& shape)
+    {
+        if constexpr (has_uninitialized_from_shape<C, S>::value)
+        {
+            return C::from_shape(std::forward<S>(shape), uninitialized);
+        }
+        else
+        {
+            return C::from_shape(std::forward<S>(shape));
+        }
+    }
+
     /*********************************
      * normalize_axis implementation *
      *********************************/
@@ -1014,6 +1113,81 @@ namespace xt
     template <class E, size_t N>
     using has_rank_t = typename has_rank<std::decay_t<E>, N>::type;
 
+    /*******************
+     * parallel_chunks *
+     *******************/
+
+    namespace detail
+    {
+        // Calls f(begin, end) on chunks of [0, count), in parallel when TBB or
+        // OpenMP is enabled.
+        template <class F>
+        inline void parallel_chunks(std::size_t count, F&& f)
+        {
+#if defined(XTENSOR_USE_TBB)
+            tbb::parallel_for(
+                tbb::blocked_range<std::size_t>(0, count),
+                [&f](const tbb::blocked_range<std::size_t>& r)
+                {
+                    f(r.begin(), r.end());
+                }
+            );
+#elif defined(XTENSOR_USE_OPENMP)
+            // One contiguous chunk per thread
+#pragma omp parallel if (count > 1)
+            {
+                const auto threads = static_cast<std::size_t>(omp_get_num_threads());
+                const auto thread = static_cast<std::size_t>(omp_get_thread_num());
+                const std::size_t chunk = count / threads;
+                const std::size_t remainder = count % threads;
+                const std::size_t begin = thread * chunk + std::min(thread, remainder);
+                const std::size_t end = begin + chunk + (thread < remainder ? 1 : 0);
+                if (begin < end)
+                {
+                    f(begin, end);
+                }
+            }
+#else
+            f(std::size_t(0), count);
+#endif
+        }
+
+        // Minimum number of elements processed by a task of parallel_chunks
+        // when the total work is given.
+        constexpr std::size_t parallel_grain = 32768;
+
+        // Same as above for count units holding work elements in total. Runs
+        // f(0, count) serially unless work fills two tasks of the grain, or
+        // of the threshold of the enabled backend if it is larger.
+        template <class F>
+        inline void parallel_chunks(std::size_t count, std::size_t work, F&& f)
+        {
+#if defined(XTENSOR_USE_TBB)
+            const std::size_t grain = std::max(parallel_grain, static_cast<std::size_t>(XTENSOR_TBB_THRESHOLD));
+#elif defined(XTENSOR_USE_OPENMP)
+            const std::size_t grain = std::max(parallel_grain, static_cast<std::size_t>(XTENSOR_OPENMP_TRESHOLD));
+#else
+            const std::size_t grain = parallel_grain;
+#endif
+            if (count <= 1 || work < 2 * grain)
+            {
+                f(std::size_t(0), count);
+                return;
+            }
+#if defined(XTENSOR_USE_TBB)
+            const std::size_t unit_work = std::max(work / count, std::size_t(1));
+            tbb::parallel_for(
+                tbb::blocked_range<std::size_t>(0, count, std::max(grain / unit_work, std::size_t(1))),
+                [&f](const tbb::blocked_range<std::size_t>& r)
+                {
+                    f(r.begin(), r.end());
+                }
+            );
+#else
+            parallel_chunks(count, std::forward<F>(f));
+#endif
+        }
+    }
 }
 
 #endif
@@ -15,11 +15,13 @@
 #include <cstddef>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <xtl/xsequence.hpp>
 
 #include "../containers/xscalar.hpp"
 #include "../core/xaccessible.hpp"
+#include "../core/xassign.hpp"
 #include "../core/xexpression.hpp"
 #include "../core/xiterable.hpp"
 #include "../core/xstrides.hpp"
@@ -226,6 +228,10 @@ namespace xt
         template <class E, xscalar_concept XCT = CT>
         void assign_to(xexpression<E>& e) const;
 
+        template <class E, class XCT = CT>
+            requires(!xscalar_concept<XCT> && detail::has_block_storage<E>::value)
+        void assign_to(xexpression<E>& e) const;
+
         template <class E>
         using rebind_t = xbroadcast<E, X>;
 
@@ -471,6 +477,113 @@ namespace xt
         std::fill(ed.begin(), ed.end(), m_e());
     }
 
+    namespace detail
+    {
+        // Result and operand of a broadcast, in block order
+        struct broadcast_block_sizes
+        {
+            block_layout dst;
+            // the operand, its shape left padded with ones
+            block_layout src;
+            // both shapes are equal from this dimension on
+            std::size_t copy_dim;
+        };
+
+        template <class S1, class S2>
+        inline broadcast_block_sizes make_broadcast_block_sizes(const S1& shape, const S2& src_shape, layout_type l)
+        {
+            const std::size_t dim = shape.size();
+            std::vector<std::size_t> padded(dim, std::size_t(1));
+            std::copy(src_shape.cbegin(), src_shape.cend(), padded.end() - std::ptrdiff_t(src_shape.size()));
+            broadcast_block_sizes res{block_layout(shape, l), block_layout(padded, l), dim};
+            while (res.copy_dim > 0 && res.dst.shape[res.copy_dim - 1] == res.src.shape[res.copy_dim - 1])
+            {
+                --res.copy_dim;
+            }
+            return res;
+        }
+
+        template <class T, class U>
+        inline void broadcast_blocks_impl(const T* src, U* dst, const broadcast_block_sizes& b, std::size_t d)
+        {
+            if (d == b.copy_dim)
+            {
+                std::copy(src, src + b.dst.size[d], dst);
+            }
+            else if (b.src.shape[d] == 1)
+            {
+                // Fill the first block, then copy it
+                if (d + 1 == b.dst.shape.size())
+                {
+                    std::fill_n(dst, b.dst.shape[d], static_cast<U>(*src));
+                }
+                else
+                {
+                    broadcast_blocks_impl(src, dst, b, d + 1);
+                    replicate_block(dst, b.dst.size[d + 1], b.dst.shape[d]);
+                }
+            }
+            else
+            {
+                for (std::size_t i = 0; i < b.dst.shape[d]; ++i)
+                {
+                    broadcast_blocks_impl(src + i * b.src.size[d + 1], dst + i * b.dst.size[d + 1], b, d + 1);
+                }
+            }
+        }
+
+        template <class T, class U>
+        inline void broadcast_blocks(const T* src, U* dst, const broadcast_block_sizes& b)
+        {
+            if (b.copy_dim != 0 && b.src.shape[0] != 1)
+            {
+                parallel_chunks(
+                    b.dst.shape[0],
+                    b.dst.size[0],
+                    [&](std::size_t begin, std::size_t end)
+                    {
+                        for (std::size_t i = begin; i < end; ++i)
+                        {
+                            broadcast_blocks_impl(src + i * b.src.size[1], dst + i * b.dst.size[1], b, 1);
+                        }
+                    }
+                );
+            }
+            else
+            {
+                broadcast_blocks_impl(src, dst, b, 0);
+            }
+        }
+    }
+
+    /**
+     * Evaluates the broadcast expression once and writes it into \a e,
+     * the broadcast dimensions being filled by copying contiguous blocks.
+     */
+    template <class CT, class X>
+    template <class E, class XCT>
+        requires(!xscalar_concept<XCT> && detail::has_block_storage<E>::value)
+    inline void xbroadcast<CT, X>::assign_to(xexpression<E>& e) const
+    {
+        auto& de = e.derived_cast();
+        const layout_type l = de.layout();
+        if (l == layout_type::row_major || l == layout_type::column_major)
+        {
+            detail::resize_for_assign(de, m_shape);
+            if (de.size() != 0)
+            {
+                detail::contiguous_operand<xexpression_type> src(m_e, l);
+                const auto sizes = detail::make_broadcast_block_sizes(m_shape, m_e.shape(), l);
+                detail::broadcast_blocks(src.data(), de.data(), sizes);
+            }
+        }
+        else
+        {
+            using tag = xexpression_tag_t<E, self_type>;
+            xexpression_assigner<tag>::assign_xexpression(e, static_cast<const xexpression<self_type>&>(*this));
+        }
+    }
+
     template <class CT, class X>
     template <class E>
     inline auto xbroadcast<CT, X>::build_broadcast(E&& e) const -> rebind_t<E>
@@ -9,14 +9,18 @@
 #ifndef XTENSOR_DYNAMIC_VIEW_HPP
 #define XTENSOR_DYNAMIC_VIEW_HPP
 
+#include <algorithm>
 #include <variant>
 
 #include <xtl/xsequence.hpp>
 
+#include "../core/xassign.hpp"
 #include "../core/xexpression.hpp"
 #include "../core/xiterable.hpp"
 #include "../core/xlayout.hpp"
+#include "../core/xnoalias.hpp"
 #include "../core/xsemantic.hpp"
+#include "../views/xstrided_view.hpp"
 #include "../views/xstrided_view_base.hpp"
 
 namespace xt
@@ -164,6 +168,20 @@ namespace xt
         template <class E>
         disable_xexpression<E, self_type>& operator=(const E& e);
 
+        template <class E>
+        self_type& assign_xexpression(const xexpression<E>& e);
+
+        template <class E>
+        self_type& computed_assign(const xexpression<E>& e);
+
+        template <class E, class F>
+        self_type& scalar_computed_assign(const E& e, F&& f);
+
+        template <class E>
+        void assign_to(xexpression<E>& e) const;
+
+        bool is_strided() const noexcept;
+
         using base_type::dimension;
         using base_type::is_contiguous;
         using base_type::layout;
@@ -248,8 +266,16 @@ namespace xt
 
         using offset_type = typename base_type::offset_type;
 
+        template <class E>
+        using strided_view_type = xstrided_view<E, S, L, typename FST::template rebind_t<E>>;
+        using strided_expression_type = std::conditional_t<is_const, const xexpression_type&, xexpression_type&>;
+
         slice_vector_type m_slices;
         inner_strides_type m_adj_strides;
+        bool m_strided;
+
+        strided_view_type<strided_expression_type> as_strided_view();
+        strided_view_type<const xexpression_type&> as_strided_view() const;
 
         container_iterator data_xbegin() noexcept;
         const_container_iterator data_xbegin() const noexcept;
@@ -393,6 +419,14 @@ namespace xt
         : base_type(std::forward<CTA>(e), std::forward<SA>(shape), std::move(strides), offset, layout)
         , m_slices(std::move(slices))
         , m_adj_strides(std::move(adj_strides))
+        , m_strided(std::all_of(
+              m_slices.cbegin(),
+              m_slices.cend(),
+              [](const slice_type& sl)
+              {
+                  return std::holds_alternative<detail::xfake_slice<strides_vt>>(sl);
+              }
+          ))
     {
     }
 
@@ -407,10 +441,92 @@ namespace xt
     template <class E>
     inline auto xdynamic_view<CT, S, L, FST>::operator=(const E& e) -> disable_xexpression<E, self_type>&
     {
-        std::fill(this->begin(), this->end(), e);
+        if (m_strided)
+        {
+            as_strided_view().fill(e);
+        }
+        else
+        {
+            std::fill(this->begin(), this->end(), e);
+        }
+        return *this;
+    }
+
+    template <class CT, class S, layout_type L, class FST>
+    template <class E>
+    inline auto xdynamic_view<CT, S, L, FST>::assign_xexpression(const xexpression<E>& e) -> self_type&
+    {
+        if (m_strided)
+        {
+            as_strided_view().assign_xexpression(e);
+        }
+        else
+        {
+            semantic_base::assign_xexpression(e);
+        }
+        return *this;
+    }
+
+    template <class CT, class S, layout_type L, class FST>
+    template <class E>
+    inline auto xdynamic_view<CT, S, L, FST>::computed_assign(const xexpression<E>& e) -> self_type&
+    {
+        if (m_strided)
+        {
+            as_strided_view().computed_assign(e);
+        }
+        else
+        {
+            semantic_base::computed_assign(e);
+        }
         return *this;
     }
 
+    template <class CT, class S, layout_type L, class FST>
+    template <class E, class F>
+    inline auto xdynamic_view<CT, S, L, FST>::scalar_computed_assign(const E& e, F&& f) -> self_type&
+    {
+        if (m_strided)
+        {
+            as_strided_view().scalar_computed_assign(e, std::forward<F>(f));
+        }
+        else
+        {
+            semantic_base::scalar_computed_assign(e, std::forward<F>(f));
+        }
+        return *this;
+    }
+
+    /**
+     * Assigns the view to \a e through the equivalent strided view when all
+     * its slices are ranges, integers or new axes, so that the strided and SIMD
+     * loops of the assigner apply.
+     */
+    template <class CT, class S, layout_type L, class FST>
+    template <class E>
+    inline void xdynamic_view<CT, S, L, FST>::assign_to(xexpression<E>& e) const
+    {
+        if (m_strided)
+        {
+            xt::assign_xexpression(e, as_strided_view());
+        }
+        else
+        {
+            using tag = xexpression_tag_t<E, self_type>;
+            xexpression_assigner<tag>::assign_xexpression(e, static_cast<const xexpression<self_type>&>(*this));
+        }
+    }
+
+    /**
+     * Returns true if the view has no keep or drop slice: its elements are
+     * then described by its shape, strides and offset only.
+     */
+    template <class CT, class S, layout_type L, class FST>
+    inline bool xdynamic_view<CT, S, L, FST>::is_strided() const noexcept
+    {
+        return m_strided;
+    }
+
     template <class CT, class S, layout_type L, class FST>
     inline auto xdynamic_view<CT, S, L, FST>::operator()() -> reference
     {
@@ -430,7 +546,7 @@ namespace xt
         XTENSOR_TRY(check_index(base_type::shape(), args...));
         XTENSOR_CHECK_DIMENSION(base_type::shape(), args...);
         offset_type offset = base_type::compute_index(args...);
-        offset = adjust_offset(offset, args...);
+        offset = m_strided ? offset : adjust_offset(offset, args...);
         return base_type::storage()[static_cast<size_type>(offset)];
     }
 
@@ -441,7 +557,7 @@ namespace xt
         XTENSOR_TRY(check_index(base_type::shape(), args...));
         XTENSOR_CHECK_DIMENSION(base_type::shape(), args...);
         offset_type offset = base_type::compute_index(args...);
-        offset = adjust_offset(offset, args...);
+        offset = m_strided ? offset : adjust_offset(offset, args...);
         return base_type::storage()[static_cast<size_type>(offset)];
     }
 
@@ -457,7 +573,7 @@ namespace xt
     inline auto xdynamic_view<CT, S, L, FST>::unchecked(Args... args) -> reference
     {
         offset_type offset = base_type::compute_unchecked_index(args...);
-        offset = adjust_offset(args...);
+        offset = m_strided ? offset : adjust_offset(offset, args...);
         return base_type::storage()[static_cast<size_type>(offset)];
     }
 
@@ -466,7 +582,7 @@ namespace xt
     inline auto xdynamic_view<CT, S, L, FST>::unchecked(Args... args) const -> const_reference
     {
         offset_type offset = base_type::compute_unchecked_index(args...);
-        offset = adjust_offset(args...);
+        offset = m_strided ? offset : adjust_offset(offset, args...);
         return base_type::storage()[static_cast<size_type>(offset)];
     }
 
@@ -488,7 +604,7 @@ namespace xt
     {
         XTENSOR_TRY(check_element_index(base_type::shape(), first, last));
         offset_type offset = base_type::compute_element_index(first, last);
-        offset = adjust_element_offset(offset, first, last);
+        offset = m_strided ? offset : adjust_element_offset(offset, first, last);
         return base_type::storage()[static_cast<size_type>(offset)];
     }
 
@@ -498,7 +614,7 @@ namespace xt
     {
         XTENSOR_TRY(check_element_index(base_type::shape(), first, last));
         offset_type offset = base_type::compute_element_index(first, last);
-        offset = adjust_element_offset(offset, first, last);
+        offset = m_strided ? offset : adjust_element_offset(offset, first, last);
         return base_type::storage()[static_cast<size_type>(offset)];
     }
 
@@ -506,6 +622,10 @@ namespace xt
     inline auto xdynamic_view<CT, S, L, FST>::data_offset() const noexcept -> size_type
     {
         size_type offset = base_type::data_offset();
+        if (m_strided)
+        {
+            return offset;
+        }
         size_type sl_offset = std::visit(
             [](const auto& sl)
             {
@@ -520,7 +640,14 @@ namespace xt
     template <class T>
     inline void xdynamic_view<CT, S, L, FST>::fill(const T& value)
     {
-        return std::fill(this->linear_begin(), this->linear_end(), value);
+        if (m_strided)
+        {
+            as_strided_view().fill(value);
+        }
+        else
+        {
+            std::fill(this->begin(), this->end(), value);
+        }
     }
 
     template <class CT, class S, layout_type L, class FST>
@@ -575,6 +702,31 @@ namespace xt
         );
     }
 
+    template <class CT, class S, layout_type L, class FST>
+    inline auto xdynamic_view<CT, S, L, FST>::as_strided_view() -> strided_view_type<strided_expression_type>
+    {
+        return strided_view_type<strided_expression_type>(
+            base_type::expression(),
+            inner_shape_type(this->shape()),
+            inner_strides_type(base_type::strides()),
+            base_type::data_offset(),
+            this->layout()
+        );
+    }
+
+    template <class CT, class S, layout_type L, class FST>
+    inline auto xdynamic_view<CT, S, L, FST>::as_strided_view() const
+        -> strided_view_type<const xexpression_type&>
+    {
+        return strided_view_type<const xexpression_type&>(
+            base_type::expression(),
+            inner_shape_type(this->shape()),
+            inner_strides_type(base_type::strides()),
+            base_type::data_offset(),
+            this->layout()
+        );
+    }
+
     template <class CT, class S, layout_type L, class FST>
     inline auto xdynamic_view<CT, S, L, FST>::data_xbegin() noexcept -> container_iterator
     {
@@ -621,7 +773,14 @@ namespace xt
     template <class CT, class S, layout_type L, class FST>
     inline void xdynamic_view<CT, S, L, FST>::assign_temporary_impl(temporary_type&& tmp)
     {
-        std::copy(tmp.cbegin(), tmp.cend(), this->begin());
+        if (m_strided)
+        {
+            noalias(as_strided_view()) = tmp;
+        }
+        else
+        {
+            std::copy(tmp.cbegin(), tmp.cend(), this->begin());
+        }
     }
 
     template <class CT, class S, layout_type L, class FST>
@@ -13,14 +13,24 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "../containers/xarray.hpp"
+#include "../containers/xtensor.hpp"
+#include "../core/xassign.hpp"
 #include "../core/xexpression.hpp"
 #include "../core/xiterable.hpp"
+#include "../core/xnoalias.hpp"
 #include "../core/xoperation.hpp"
 #include "../core/xsemantic.hpp"
 #include "../core/xstrides.hpp"
+#include "../utils/xtensor_simd.hpp"
 #include "../utils/xutils.hpp"
 
 namespace xt
@@ -57,6 +67,15 @@ namespace xt
     template <class CT, class I>
     class xindex_view;
 
+    /**
+     * The elements of an index view of an expression with a data interface
+     * are gathered from its storage, which provides the SIMD interface of
+     * the view.
+     */
+    template <class E>
+    concept xindex_view_gather_concept = has_data_interface<E>::value && has_strides<E>::value
+                                         && has_simd_interface<E>::value;
+
     template <class CT, class I>
     struct xcontainer_inner_types<xindex_view<CT, I>>
     {
@@ -140,6 +159,7 @@ namespace xt
         size_type shape(size_type index) const;
         layout_type layout() const noexcept;
         bool is_contiguous() const noexcept;
+        bool linear_gather() const noexcept;
 
         template <class T>
         void fill(const T& value);
@@ -177,7 +197,7 @@ namespace xt
         bool broadcast_shape(O& shape, bool reuse_cache = false) const;
 
         template <class O>
-        bool has_linear_assign(const O& /*strides*/) const noexcept;
+        bool has_linear_assign(const O& strides) const noexcept;
 
         template <class ST>
         stepper stepper_begin(const ST& shape);
@@ -195,12 +215,41 @@ namespace xt
         template <class E>
         rebind_t<E> build_index_view(E&& e) const;
 
+        //
+        // SIMD interface
+        //
+
+        template <class requested_type>
+        using simd_return_type = xt_simd::simd_return_type<value_type, requested_type>;
+
+        template <class align, class simd, class T = xexpression_type>
+        void store_simd(size_type i, const simd& e)
+            requires(xindex_view_gather_concept<T>);
+
+        template <
+            class align,
+            class requested_type = value_type,
+            std::size_t N = xt_simd::simd_traits<requested_type>::size,
+            class T = xexpression_type>
+        simd_return_type<requested_type> load_simd(size_type i) const
+            requires(xindex_view_gather_concept<T>);
+
+        template <class T = xexpression_type>
+        reference data_element(size_type i)
+            requires(xindex_view_gather_concept<T>);
+
+        template <class T = xexpression_type>
+        const_reference data_element(size_type i) const
+            requires(xindex_view_gather_concept<T>);
+
     private:
 
         CT m_e;
         const indices_type m_indices;
         const inner_shape_type m_shape;
 
+        size_type storage_offset(size_type i) const;
+
         void assign_temporary_impl(temporary_type&& tmp);
 
         friend class xview_semantic<xindex_view<CT, I>>;
@@ -363,18 +412,46 @@ namespace xt
         return m_shape[i];
     }
 
+    /**
+     * Returns the layout of the view: row_major when its elements are gathered
+     * linearly from the storage of the underlying expression, dynamic otherwise.
+     */
     template <class CT, class I>
     inline layout_type xindex_view<CT, I>::layout() const noexcept
     {
-        return static_layout;
+        return linear_gather() ? layout_type::row_major : static_layout;
     }
 
+    /**
+     * Checks whether the view is contiguous, which is never the case: its
+     * elements are scattered in the underlying expression.
+     * @sa linear_gather
+     */
     template <class CT, class I>
     inline bool xindex_view<CT, I>::is_contiguous() const noexcept
     {
         return false;
     }
 
+    /**
+     * Checks whether the elements of the view are gathered linearly from the
+     * storage of the underlying expression, which happens for flat integer
+     * indices or 1-D underlying expressions with a data interface. Such views
+     * can be read in linear order through their SIMD interface.
+     */
+    template <class CT, class I>
+    inline bool xindex_view<CT, I>::linear_gather() const noexcept
+    {
+        if constexpr (xindex_view_gather_concept<xexpression_type>)
+        {
+            return std::is_integral<std::decay_t<decltype(m_indices[0])>>::value || m_e.dimension() == 1;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
     //@}
 
     /**
@@ -571,9 +648,9 @@ namespace xt
      */
     template <class CT, class I>
     template <class O>
-    inline bool xindex_view<CT, I>::has_linear_assign(const O& /*strides*/) const noexcept
+    inline bool xindex_view<CT, I>::has_linear_assign(const O& strides) const noexcept
     {
-        return false;
+        return linear_gather() && strides.size() == 1;
     }
 
     //@}
@@ -621,6 +698,70 @@ namespace xt
         return rebind_t<E>(std::forward<E>(e), indices_type(m_indices));
     }
 
+    template <class CT, class I>
+    template <class align, class simd, class T>
+    inline auto xindex_view<CT, I>::store_simd(size_type i, const simd& e) -> void
+        requires(xindex_view_gather_concept<T>)
+    {
+        // Store to a buffer, then scatter its values one by one
+        constexpr std::size_t size = xt_simd::revert_simd_traits<simd>::size;
+        std::array<value_type, size> buffer;
+        xt_simd::store_as(buffer.data(), e, xt_simd::unaligned_mode());
+        for (std::size_t k = 0; k < size; ++k)
+        {
+            data_element(i + k) = buffer[k];
+        }
+    }
+
+    template <class CT, class I>
+    template <class align, class requested_type, std::size_t N, class T>
+    inline auto xindex_view<CT, I>::load_simd(size_type i) const -> simd_return_type<requested_type>
+        requires(xindex_view_gather_concept<T>)
+    {
+        // Unrolled scalar gather, then a single load of the gathered values
+        std::array<value_type, N> buffer;
+        for (std::size_t k = 0; k < N; ++k)
+        {
+            buffer[k] = data_element(i + k);
+        }
+        return xt_simd::load_as<requested_type>(buffer.data(), xt_simd::unaligned_mode());
+    }
+
+    template <class CT, class I>
+    template <class T>
+    inline auto xindex_view<CT, I>::data_element(size_type i) -> reference
+        requires(xindex_view_gather_concept<T>)
+    {
+        return m_e.data_element(storage_offset(i));
+    }
+
+    template <class CT, class I>
+    template <class T>
+    inline auto xindex_view<CT, I>::data_element(size_type i) const -> const_reference
+        requires(xindex_view_gather_concept<T>)
+    {
+        return m_e.data_element(storage_offset(i));
+    }
+
+    // Offset in the storage of the underlying expression of the i-th element,
+    // consistent with m_e[m_indices[i]]
+    template <class CT, class I>
+    inline auto xindex_view<CT, I>::storage_offset(size_type i) const -> size_type
+    {
+        const auto& index = m_indices[i];
+        const auto& strides = m_e.strides();
+        if constexpr (std::is_integral<std::decay_t<decltype(index)>>::value)
+        {
+            return strides.size() == 0
+                       ? size_type(0)
+                       : static_cast<size_type>(static_cast<std::ptrdiff_t>(index) * static_cast<std::ptrdiff_t>(strides.back()));
+        }
+        else
+        {
+            return static_cast<size_type>(element_offset<std::ptrdiff_t>(strides, index.cbegin(), index.cend()));
+        }
+    }
+
     /******************************
      * xfiltration implementation *
      ******************************/
@@ -848,6 +989,232 @@ namespace xt
         using filtration_type = xfiltration<xclosure_t<E>, xclosure_t<C>>;
         return filtration_type(std::forward<E>(e), std::forward<C>(condition));
     }
+
+    /*********************
+     * extract and place *
+     *********************/
+
+    namespace detail
+    {
+        // Number of elements processed by a task of extract and place
+        constexpr std::size_t compress_block = 4096;
+
+        template <class E, class O>
+        inline void check_compress_shape(const E& e, const O& condition, const char* name)
+        {
+            if (e.dimension() != condition.dimension()
+                || !std::equal(e.shape().cbegin(), e.shape().cend(), condition.shape().cbegin()))
+            {
+                XTENSOR_THROW(std::runtime_error, std::string(name) + ": condition must have the shape of the expression");
+            }
+        }
+
+        // offsets[b] is the number of true values of the mask before block b,
+        // the last element holds the total count.
+        template <class M>
+        inline std::vector<std::size_t> compress_offsets(const M* mask, std::size_t size)
+        {
+            const std::size_t n_blocks = (size + compress_block - 1) / compress_block;
+            std::vector<std::size_t> offsets(n_blocks + 1, std::size_t(0));
+            parallel_chunks(
+                n_blocks,
+                [&](std::size_t first, std::size_t last)
+                {
+                    for (std::size_t b = first; b < last; ++b)
+                    {
+                        const std::size_t begin = b * compress_block;
+                        const std::size_t end = std::min(begin + compress_block, size);
+                        std::size_t count = 0;
+                        for (std::size_t i = begin; i < end; ++i)
+                        {
+                            count += static_cast<bool>(mask[i]) ? std::size_t(1) : std::size_t(0);
+                        }
+                        offsets[b + 1] = count;
+                    }
+                }
+            );
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+            return offsets;
+        }
+
+        // Left-packs the selected elements of each block into out. Elements
+        // are written unconditionally to a staging buffer whose cursor only
+        // advances on selected ones, so that the loop has no branch.
+        template <class T, class M>
+        inline void compress_blocks(const T* src, const M* mask, std::size_t size, const std::vector<std::size_t>& offsets, T* out)
+        {
+            parallel_chunks(
+                offsets.size() - 1,
+                [&](std::size_t first, std::size_t last)
+                {
+                    std::unique_ptr<T[]> staging;
+                    for (std::size_t b = first; b < last; ++b)
+                    {
+                        const std::size_t begin = b * compress_block;
+                        const std::size_t end = std::min(begin + compress_block, size);
+                        const std::size_t count = offsets[b + 1] - offsets[b];
+                        if (count == end - begin)
+                        {
+                            std::copy(src + begin, src + end, out + offsets[b]);
+                        }
+                        else if (count != 0)
+                        {
+                            if (!staging)
+                            {
+                                staging.reset(new T[compress_block]);
+                            }
+                            std::size_t k = 0;
+                            for (std::size_t i = begin; i < end; ++i)
+                            {
+                                staging[k] = src[i];
+                                k += static_cast<bool>(mask[i]) ? std::size_t(1) : std::size_t(0);
+                            }
+                            std::copy(staging.get(), staging.get() + count, out + offsets[b]);
+                        }
+                    }
+                }
+            );
+        }
+
+        // Scatters values, cycled, to the selected elements of dst.
+        template <class T, class M, class V>
+        inline void expand_blocks(T* dst, const M* mask, std::size_t size, const std::vector<std::size_t>& offsets, const V* values, std::size_t n_values)
+        {
+            const bool cycle = n_values < offsets.back();
+            parallel_chunks(
+                offsets.size() - 1,
+                [&](std::size_t first, std::size_t last)
+                {
+                    for (std::size_t b = first; b < last; ++b)
+                    {
+                        const std::size_t begin = b * compress_block;
+                        const std::size_t end = std::min(begin + compress_block, size);
+                        std::size_t k = offsets[b];
+                        if (offsets[b + 1] - k == end - begin && !cycle)
+                        {
+                            std::transform(
+                                values + k,
+                                values + k + (end - begin),
+                                dst + begin,
+                                [](const V& v)
+                                {
+                                    return static_cast<T>(v);
+                                }
+                            );
+                        }
+                        else if (offsets[b + 1] != k)
+                        {
+                            for (std::size_t i = begin; i < end; ++i)
+                            {
+                                if (mask[i])
+                                {
+                                    dst[i] = static_cast<T>(values[cycle ? k % n_values : k]);
+                                    ++k;
+                                }
+                            }
+                        }
+                    }
+                }
+            );
+        }
+    }
+
+    /**
+     * @brief copies the elements of \c e where \a condition is true into a
+     * 1-D tensor.
+     *
+     * Returns the same elements as the evaluation of \ref filter, but the
+     * selected elements are packed directly into the result buffer instead
+     * of going through a list of indices. The expressions are read in the
+     * layout \a L. This is the equivalent of numpy's \c extract.
+     *
+     * @param e the \ref xexpression to extract elements from
+     * @param condition the boolean \ref xexpression, with the shape of \c e
+     * @tparam L the traversal order
+     *
+     * @code{.cpp}
+     * xarray<double> a = {{1,5,3}, {4,5,6}};
+     * auto b = extract(a, a >= 5);
+     * std::cout << b << std::endl; // {5, 5, 6}
+     * @endcode
+     */
+    template <layout_type L = XTENSOR_DEFAULT_TRAVERSAL, class E, class O>
+    inline auto extract(const xexpression<E>& e, const xexpression<O>& condition)
+    {
+        const E& de = e.derived_cast();
+        const O& dcond = condition.derived_cast();
+        detail::check_compress_shape(de, dcond, "extract");
+
+        using value_type = typename E::value_type;
+        detail::contiguous_operand<E> src(de, L);
+        detail::contiguous_operand<O> mask(dcond, L);
+        const std::size_t size = de.size();
+        const auto offsets = detail::compress_offsets(mask.data(), size);
+
+        using result_type = xtensor<value_type, 1>;
+        auto res = result_type::from_shape(std::array<std::size_t, 1>{offsets.back()}, uninitialized);
+        detail::compress_blocks(src.data(), mask.data(), size, offsets, res.data());
+        return res;
+    }
+
+    /**
+     * @brief writes \a values into the elements of \c e where \a condition
+     * is true.
+     *
+     * The elements of \a values are used in order, in the layout \a L, and
+     * repeated when they are fewer than the selected elements. This is the
+     * inverse of \ref extract and the equivalent of numpy's \c place.
+     *
+     * @param e the \ref xexpression to modify
+     * @param condition the boolean \ref xexpression, with the shape of \c e
+     * @param values the \ref xexpression holding the values to write
+     * @tparam L the traversal order
+     *
+     * @code{.cpp}
+     * xarray<double> a = {{1,5,3}, {4,5,6}};
+     * place(a, a >= 5, xarray<double>{0, -1});
+     * std::cout << a << std::endl; // {{1, 0, 3}, {4, -1, 0}}
+     * @endcode
+     */
+    template <layout_type L = XTENSOR_DEFAULT_TRAVERSAL, class E, class O, class V>
+    inline void place(xexpression<E>& e, const xexpression<O>& condition, const xexpression<V>& values)
+    {
+        E& de = e.derived_cast();
+        const O& dcond = condition.derived_cast();
+        detail::check_compress_shape(de, dcond, "place");
+
+        using value_type = typename E::value_type;
+        detail::contiguous_operand<O> mask(dcond, L);
+        const std::size_t size = de.size();
+        const auto offsets = detail::compress_offsets(mask.data(), size);
+        if (offsets.back() == 0)
+        {
+            return;
+        }
+
+        const V& dvalues = values.derived_cast();
+        if (dvalues.size() == 0)
+        {
+            XTENSOR_THROW(std::runtime_error, "place: values cannot be empty when condition selects elements");
+        }
+        detail::contiguous_operand<V> vals(dvalues, L);
+
+        bool in_place = false;
+        if constexpr (has_data_interface<E>::value && !std::is_const<std::remove_reference_t<decltype(*de.data())>>::value)
+        {
+            if (de.is_contiguous() && (de.layout() == L || de.dimension() <= 1))
+            {
+                detail::expand_blocks(de.data() + de.data_offset(), mask.data(), size, offsets, vals.data(), dvalues.size());
+                in_place = true;
+            }
+        }
+        if (!in_place)
+        {
+            xarray<value_type, L> tmp = de;
+            detail::expand_blocks(tmp.data(), mask.data(), size, offsets, vals.data(), dvalues.size());
+            noalias(de) = tmp;
+        }
+    }
 }
 
 #endif
@@ -13,11 +13,14 @@
 #include "../core/xaccessible.hpp"
 #include "../core/xexpression.hpp"
 #include "../core/xiterable.hpp"
+#include "../core/xnoalias.hpp"
+#include "../core/xoperation.hpp"
 #include "../core/xsemantic.hpp"
 #include "../core/xshape.hpp"
 #include "../core/xtensor_forward.hpp"
 #include "../utils/xutils.hpp"
 #include "xtl/xmasked_value.hpp"
+#include "xtl/xoptional.hpp"
 
 namespace xt
 {
@@ -565,6 +568,22 @@ namespace xt
         return const_stepper(value().stepper_end(shape, l), visible().stepper_end(shape, l));
     }
 
+    namespace detail
+    {
+        // Assigning plain values to a masked view on plain data is computed
+        // as a select between the new values and the current data, which the
+        // linear and strided assign loops evaluate with SIMD blends instead of
+        // a branch per element.
+        template <class D, class M, class T>
+        struct masked_view_select_assign
+            : std::bool_constant<
+                  !xtl::is_xoptional<typename D::value_type>::value
+                  && !xtl::is_xmasked_value<typename D::value_type>::value && !xtl::is_xoptional<T>::value
+                  && !xtl::is_xmasked_value<T>::value && std::is_same<typename M::value_type, bool>::value>
+        {
+        };
+    }
+
     template <class CTD, class CTM>
     inline auto xmasked_view<CTD, CTM>::operator=(const self_type& rhs) -> self_type&
     {
@@ -576,6 +595,25 @@ namespace xt
     template <class E>
     inline auto xmasked_view<CTD, CTM>::operator=(const xexpression<E>& e) -> self_type&
     {
+        if constexpr (detail::masked_view_select_assign<data_type, mask_type, typename E::value_type>::value)
+        {
+            const E& de = e.derived_cast();
+            if (same_shape(m_data.shape(), de.shape()) && same_shape(m_data.shape(), m_mask.shape()))
+            {
+                if (make_overlapping_memory_checker(m_data).check_overlap(de))
+                {
+                    // The expression may read the data at other indices than the
+                    // written ones, it is evaluated before the select
+                    typename data_type::temporary_type tmp = de;
+                    noalias(m_data) = where(m_mask, tmp, m_data);
+                }
+                else
+                {
+                    noalias(m_data) = where(m_mask, de, m_data);
+                }
+                return *this;
+            }
+        }
         return semantic_base::operator=(e);
     }
 
@@ -583,6 +621,14 @@ namespace xt
     template <class E>
     inline auto xmasked_view<CTD, CTM>::operator=(const E& e) -> disable_xexpression<E, self_type>&
     {
+        if constexpr (detail::masked_view_select_assign<data_type, mask_type, E>::value)
+        {
+            if (same_shape(m_data.shape(), m_mask.shape()))
+            {
+                noalias(m_data) = where(m_mask, e, m_data);
+                return *this;
+            }
+        }
         std::fill(this->begin(), this->end(), e);
         return *this;
     }
@@ -10,12 +10,17 @@
 #ifndef XTENSOR_XREPEAT
 #define XTENSOR_XREPEAT
 
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
 #include <utility>
 #include <vector>
 
 #include "../core/xaccessible.hpp"
+#include "../core/xassign.hpp"
 #include "../core/xexpression.hpp"
 #include "../core/xiterable.hpp"
+#include "../utils/xutils.hpp"
 
 namespace xt
 {
@@ -160,6 +165,10 @@ namespace xt
         const_stepper stepper_end(layout_type l) const;
         const_stepper stepper_end(const shape_type& s, layout_type l) const;
 
+        template <class E>
+            requires(detail::has_block_storage<E>::value)
+        void assign_to(xexpression<E>& e) const;
+
     private:
 
         CT m_e;
@@ -450,6 +459,85 @@ namespace xt
         return st;
     }
 
+    namespace detail
+    {
+        // Row major repetition: src holds outer slices of n blocks of inner
+        // elements, block i is written repeats[i] times in a row.
+        template <class T, class U, class R>
+        inline void repeat_blocks(
+            const T* src,
+            U* dst,
+            std::size_t outer,
+            std::size_t n,
+            std::size_t inner,
+            const R& repeats
+        )
+        {
+            const auto total = static_cast<std::size_t>(
+                std::accumulate(repeats.begin(), repeats.end(), std::size_t(0))
+            );
+            parallel_chunks(
+                outer,
+                outer * total * inner,
+                [=, &repeats](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t o = begin; o < end; ++o)
+                    {
+                        const T* in = src + o * n * inner;
+                        U* out = dst + o * total * inner;
+                        for (std::size_t i = 0; i < n; ++i, in += inner)
+                        {
+                            const auto count = static_cast<std::size_t>(repeats[i]);
+                            if (count == 0)
+                            {
+                                continue;
+                            }
+                            if (inner == 1)
+                            {
+                                std::fill_n(out, count, static_cast<U>(*in));
+                            }
+                            else
+                            {
+                                std::copy(in, in + inner, out);
+                                replicate_block(out, inner, count);
+                            }
+                            out += count * inner;
+                        }
+                    }
+                }
+            );
+        }
+    }
+
+    /**
+     * Evaluates the repeated expression once and writes its blocks into
+     * \a e, contiguous blocks being copied instead of stepped through.
+     */
+    template <class CT, class R>
+    template <class E>
+        requires(detail::has_block_storage<E>::value)
+    inline void xrepeat<CT, R>::assign_to(xexpression<E>& e) const
+    {
+        auto& de = e.derived_cast();
+        const layout_type l = de.layout();
+        if (l == layout_type::row_major || l == layout_type::column_major)
+        {
+            detail::resize_for_assign(de, m_shape);
+            if (de.size() != 0)
+            {
+                detail::contiguous_operand<xexpression_type> src(m_e, l);
+                const detail::block_layout b(m_e.shape(), l);
+                const std::size_t d = b.axis(m_repeating_axis);
+                detail::repeat_blocks(src.data(), de.data(), b.outer(d), b.shape[d], b.size[d + 1], m_repeats);
+            }
+        }
+        else
+        {
+            using tag = xexpression_tag_t<E, self_type>;
+            xexpression_assigner<tag>::assign_xexpression(e, static_cast<const xexpression<self_type>&>(*this));
+        }
+    }
+
     template <class CT, class R>
     template <std::size_t I, class Arg, class... Args>
     inline auto xrepeat<CT, R>::access_impl(stepper&& s, Arg arg, Args... args) const -> const_reference
@@ -16,6 +16,8 @@
 #include "xtensor/core/xassign.hpp"
 #include "xtensor/core/xlayout.hpp"
 #include "xtensor/core/xnoalias.hpp"
+#include "xtensor/generators/xbuilder.hpp"
+#include "xtensor/misc/xmanipulation.hpp"
 #include "xtensor/views/xview.hpp"
 
 #include "test_common.hpp"
@@ -90,7 +92,8 @@ namespace xt
                 std::vector<size_t>{3, 4},
                 std::vector<size_t>{5, 1}
             );
-            EXPECT_FALSE(check_strided_assign(adapter_strided_noncont, xt::transpose(adapter_strided_cont)));
+            // the inner dimension of the transposed expression is gathered
+            EXPECT_TRUE(check_strided_assign(adapter_strided_noncont, xt::transpose(adapter_strided_cont)));
             auto contiguous_view = xt::view(simple_xtensor_12, xt::range(0, 3), xt::all());
             EXPECT_TRUE(check_linear_assign(contiguous_view, adapter_strided_cont));
             EXPECT_FALSE(check_linear_assign(contiguous_view, xt::transpose(adapter_strided_noncont)));
@@ -196,4 +199,79 @@ namespace xt
             }
         }
     }
+
+    TEST(xassign_strided, inner_stride)
+    {
+        using xt::placeholders::_;
+        xt::xtensor<double, 2> a = xt::arange<double>(6 * 24).reshape({6, 24});
+
+        auto check = [](auto&& rhs)
+        {
+            xt::xtensor<double, 2> res = xt::xtensor<double, 2>::from_shape({rhs.shape()[0], rhs.shape()[1]});
+            auto sizes = strided_assign_detail::get_loop_sizes(res, rhs);
+            EXPECT_TRUE(sizes.can_do_strided_assign);
+            EXPECT_TRUE(sizes.is_row_major);
+            EXPECT_EQ(sizes.inner_loop_size, rhs.shape()[1]);
+
+            xt::noalias(res) = rhs;
+            EXPECT_EQ(res, rhs);
+        };
+
+        // decimation, interleaved channels, reversed and transposed expressions
+        check(xt::view(a, xt::all(), xt::range(0, _, 2)));
+        check(xt::view(a, xt::all(), xt::range(1, _, 3)));
+        check(xt::view(a, xt::range(0, _, 2), xt::range(_, _, -1)));
+        check(xt::view(a, xt::all(), xt::range(0, _, 4)) + xt::view(a, xt::all(), xt::range(3, _, 4)));
+        check(xt::transpose(xt::view(a, xt::range(0, 5), xt::all())));
+        check(2. * xt::view(a, xt::all(), xt::range(2, 20, 3)));
+    }
+
+    TEST(xassign_strided, transpose_tiles)
+    {
+        // extents that are not multiples of the tile size
+        xt::xarray<double> a = xt::arange<double>(20 * 37 * 70).reshape({20, 37, 70});
+
+        auto check = [](auto&& res, auto&& rhs)
+        {
+            auto tile_dims = transpose_assigner<true>::get_tile_dims(res, rhs);
+            EXPECT_TRUE(tile_dims.can_do_transpose_assign);
+
+            xt::noalias(res) = rhs;
+            EXPECT_EQ(res, rhs);
+        };
+
+        auto make_res = [](const auto& rhs, xt::layout_type l)
+        {
+            using shape_type = std::vector<std::size_t>;
+            return xt::xarray<double, xt::layout_type::dynamic>(
+                shape_type({rhs.shape()[0], rhs.shape()[1], rhs.shape()[2]}),
+                l
+            );
+        };
+
+        auto t = xt::transpose(a);
+        check(make_res(t, xt::layout_type::row_major), t);
+        auto s = xt::swapaxes(a, 1, 2);
+        check(make_res(s, xt::layout_type::row_major), s);
+        auto m = xt::moveaxis(a, 2, 0);
+        check(make_res(m, xt::layout_type::row_major), m);
+        // a column major destination is contiguous along the first axis
+        check(make_res(a, xt::layout_type::column_major), a);
+
+        // the tiles also apply to views that start inside the storage
+        auto v = xt::transpose(xt::view(a, 1, xt::range(2, 35), xt::all()));
+        xt::xtensor<double, 2> res = xt::transpose(xt::view(a, 1, xt::range(2, 35), xt::all()));
+        EXPECT_TRUE(transpose_assigner<true>::get_tile_dims(res, v).can_do_transpose_assign);
+        EXPECT_EQ(res, v);
+
+        // large enough to be shared between threads
+        xt::xarray<double> large = xt::arange<double>(24 * 64 * 96).reshape({24, 64, 96});
+        xt::xarray<double> large_res = xt::transpose(large);
+        EXPECT_EQ(large_res, xt::transpose(large));
+
+        // short contiguous extents keep the other loops
+        xt::xarray<double> small = {{1., 2., 3.}, {4., 5., 6.}};
+        xt::xarray<double> small_res = xt::transpose(small);
+        EXPECT_FALSE(transpose_assigner<true>::get_tile_dims(small_res, xt::transpose(small)).can_do_transpose_assign);
+    }
 }
@@ -0,0 +1,164 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay and Wolf Vollprecht          *
+ * Copyright (c) QuantStack                                                 *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include <cstdint>
+
+#include "xtensor/containers/xarray.hpp"
+#include "xtensor/containers/xtensor.hpp"
+#include "xtensor/core/xmath.hpp"
+#include "xtensor/utils/xallocator.hpp"
+
+#include "test_common_macros.hpp"
+
+namespace xt
+{
+    using huge_allocator = huge_page_allocator<double>;
+    using huge_array = xarray_container<uvector<double, huge_allocator>>;
+    using huge_tensor = xtensor_container<uvector<double, huge_allocator>, 2>;
+
+    TEST(huge_page_allocator, small_allocation)
+    {
+        huge_allocator alloc;
+        EXPECT_FALSE(huge_allocator::uses_huge_pages(16));
+        double* p = alloc.allocate(16);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignof(double), std::uintptr_t(0));
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            p[i] = double(i);
+        }
+        EXPECT_EQ(p[15], 15.);
+        alloc.deallocate(p, 16);
+    }
+
+    TEST(huge_page_allocator, large_allocation)
+    {
+        huge_allocator alloc;
+        std::size_t n = XTENSOR_HUGE_PAGE_THRESHOLD / sizeof(double) + 3;
+        EXPECT_TRUE(huge_allocator::uses_huge_pages(n));
+        double* p = alloc.allocate(n);
+        p[0] = 1.;
+        p[n - 1] = 2.;
+        EXPECT_EQ(p[0] + p[n - 1], 3.);
+        alloc.deallocate(p, n);
+    }
+
+    TEST(huge_page_allocator, numa_policy)
+    {
+        huge_page::set_numa_policy(huge_page::numa_policy::interleave);
+        huge_allocator alloc;
+        std::size_t n = XTENSOR_HUGE_PAGE_THRESHOLD / sizeof(double);
+        double* p = alloc.allocate(n);
+        p[n / 2] = 4.;
+        EXPECT_EQ(p[n / 2], 4.);
+        alloc.deallocate(p, n);
+        huge_page::set_numa_policy(huge_page::numa_policy::local);
+        EXPECT_TRUE(huge_page::settings().policy == huge_page::numa_policy::local);
+    }
+
+    TEST(huge_page_allocator, containers)
+    {
+        std::size_t n = XTENSOR_HUGE_PAGE_THRESHOLD / sizeof(double);
+        huge_tensor a = huge_tensor::from_shape({n / 64, std::size_t(128)});
+        first_touch(a);
+        EXPECT_EQ(a(0, 0), 0.);
+        EXPECT_EQ(a(n / 64 - 1, 127), 0.);
+
+        a.fill(2.);
+        huge_tensor b = a + a;
+        EXPECT_EQ(b(3, 5), 4.);
+        EXPECT_EQ(sum(b)(), 4. * double(a.size()));
+
+        huge_array c = {{1., 2.}, {3., 4.}};
+        huge_array d = c * 2.;
+        EXPECT_EQ(d(1, 1), 8.);
+    }
+
+    TEST(huge_page_allocator, equality)
+    {
+        huge_allocator a1;
+        huge_page_allocator<float> a2;
+        EXPECT_TRUE(a1 == a2);
+        EXPECT_FALSE(a1 != a2);
+    }
+
+    using pool_tensor = xtensor_container<uvector<double, pool_allocator<double>>, 2>;
+
+    TEST(pool_allocator, recycling)
+    {
+        storage_pool::clear();
+        storage_pool::reset_stats();
+        pool_allocator<double> alloc;
+        double* p1 = alloc.allocate(100);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p1) % 64, std::uintptr_t(0));
+        EXPECT_EQ(storage_pool::stats().misses, std::size_t(1));
+        alloc.deallocate(p1, 100);
+        EXPECT_EQ(storage_pool::stats().recycled, std::size_t(1));
+        EXPECT_EQ(storage_pool::cached_bytes(), std::size_t(1024));
+
+        // Same size class, possibly through another value type
+        pool_allocator<float> falloc;
+        float* p2 = falloc.allocate(250);
+        EXPECT_EQ(static_cast<void*>(p2), static_cast<void*>(p1));
+        EXPECT_EQ(storage_pool::stats().hits, std::size_t(1));
+        EXPECT_EQ(storage_pool::cached_bytes(), std::size_t(0));
+        falloc.deallocate(p2, 250);
+
+        storage_pool::clear();
+        EXPECT_EQ(storage_pool::cached_bytes(), std::size_t(0));
+    }
+
+    TEST(pool_allocator, max_cached_bytes)
+    {
+        storage_pool::clear();
+        storage_pool::reset_stats();
+        storage_pool::set_max_cached_bytes(512);
+        pool_allocator<double> alloc;
+        double* p = alloc.allocate(100);
+        alloc.deallocate(p, 100);
+        EXPECT_EQ(storage_pool::stats().released, std::size_t(1));
+        EXPECT_EQ(storage_pool::cached_bytes(), std::size_t(0));
+        storage_pool::set_max_cached_bytes(XTENSOR_STORAGE_POOL_MAX_CACHED);
+    }
+
+    TEST(pool_allocator, uncacheable_block)
+    {
+        // Larger than the cache can ever hold: exact size, released on deallocation
+        storage_pool::clear();
+        storage_pool::reset_stats();
+        storage_pool::set_max_cached_bytes(std::size_t(-1));
+        const std::size_t n = XTENSOR_STORAGE_POOL_MAX_CACHED / sizeof(double) + 1;
+        pool_allocator<double> alloc;
+        double* p = alloc.allocate(n);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 64, std::uintptr_t(0));
+        p[0] = 1.;
+        p[n - 1] = 2.;
+        EXPECT_EQ(storage_pool::stats().misses, std::size_t(1));
+        alloc.deallocate(p, n);
+        EXPECT_EQ(storage_pool::stats().released, std::size_t(1));
+        EXPECT_EQ(storage_pool::cached_bytes(), std::size_t(0));
+        storage_pool::set_max_cached_bytes(XTENSOR_STORAGE_POOL_MAX_CACHED);
+    }
+
+    TEST(pool_allocator, steady_state)
+    {
+        storage_pool::clear();
+        pool_tensor a = pool_tensor::from_shape({16, 16});
+        a.fill(1.5);
+        pool_tensor b = a;
+        storage_pool::reset_stats();
+        for (std::size_t i = 0; i < 10; ++i)
+        {
+            pool_tensor tmp = a * b;
+            EXPECT_EQ(tmp(15, 15), 2.25);
+        }
+        EXPECT_LE(storage_pool::stats().misses, std::size_t(1));
+        EXPECT_GE(storage_pool::stats().hits, std::size_t(9));
+        storage_pool::clear();
+    }
+}
@@ -8,6 +8,7 @@
  ****************************************************************************/
 
 
+#include <complex>
 #include <type_traits>
 
 #include "xtensor/containers/xarray.hpp"
@@ -47,6 +48,22 @@ namespace xt
             EXPECT_EQ(expected_shape, ca.shape());
             EXPECT_EQ(shp_as_vec, cb.shape());
         }
+
+        SUBCASE("uninitialized")
+        {
+            column_major_result<> cm;
+            xarray<int, layout_type::column_major> ca(cm.m_shape, uninitialized);
+            compare_shape(ca, cm);
+
+            xarray_dynamic ra(cm.m_shape, uninitialized, layout_type::column_major);
+            compare_shape(ra, cm);
+
+            std::vector<std::size_t> shp = {3, 2, 1};
+            auto cc = xarray<std::complex<double>>::from_shape(shp, uninitialized);
+            EXPECT_EQ(shp, cc.shape());
+            cc = xt::ones<double>(shp) * std::complex<double>(1., 2.);
+            EXPECT_EQ(std::complex<double>(1., 2.), cc(2, 1, 0));
+        }
     }
 
     TEST(xarray, strided_constructor)
@@ -449,4 +466,30 @@ namespace xt
         EXPECT_TRUE(d(2));
         EXPECT_FALSE(d(3));
     }
+
+    TEST(xarray, compact_shape)
+    {
+        using compact_type = xarray_compact<double, 4>;
+        EXPECT_TRUE(sizeof(compact_type) < sizeof(xarray<double>));
+        EXPECT_TRUE(std::is_nothrow_move_constructible<compact_type>::value);
+
+        compact_type a = {{1., 2., 3.}, {4., 5., 6.}};
+        xarray<double> b = {{1., 2., 3.}, {4., 5., 6.}};
+        EXPECT_EQ(a.dimension(), size_t(2));
+        EXPECT_EQ(a.strides()[0], 3);
+        EXPECT_EQ(a.backstrides()[1], 2);
+
+        compact_type c = 2. * a + b;
+        EXPECT_EQ(c(1, 2), 18.);
+
+        // More dimensions than the inline capacity
+        compact_type d = compact_type::from_shape({2, 1, 3, 1, 1, 2});
+        d.fill(1.);
+        EXPECT_EQ(d.dimension(), size_t(6));
+        EXPECT_EQ(d.size(), size_t(12));
+        d.reshape({3, 4});
+        EXPECT_EQ(d.dimension(), size_t(2));
+        compact_type e = d;
+        EXPECT_EQ(d, e);
+    }
 }
@@ -9,6 +9,8 @@
 
 
 #include "xtensor/containers/xarray.hpp"
+#include "xtensor/containers/xtensor.hpp"
+#include "xtensor/generators/xbuilder.hpp"
 #include "xtensor/views/xbroadcast.hpp"
 
 #include "test_common.hpp"
@@ -183,4 +185,32 @@ namespace xt
         EXPECT_EQ(cm_arr(1, 1), 11.0);
         EXPECT_EQ(cm_arr(1, 2), 12.0);
     }
+
+    TEST(xbroadcast, assign_blocks)
+    {
+        xarray<double> a = arange<double>(3 * 5).reshape({3, 1, 5});
+
+        auto b = broadcast(a, {2, 3, 4, 5});
+        xarray<double> rm = b;
+        EXPECT_EQ(rm, b);
+        xarray<double, layout_type::column_major> cm = b;
+        EXPECT_EQ(cm, b);
+        xtensor<double, 4> t = b;
+        EXPECT_EQ(t, b);
+
+        auto fb = broadcast(a + 1., {2, 3, 4, 5});
+        xarray<double, layout_type::column_major> fcm = fb;
+        EXPECT_EQ(fcm, fb);
+
+        xarray<double> row = {1., 2., 3.};
+        xarray<double> col = xarray<double>::from_shape({2, 1});
+        col(0, 0) = 1.;
+        col(1, 0) = 2.;
+        xarray<double> r = broadcast(row, {2, 3});
+        xarray<double> c = broadcast(col, {2, 3});
+        xarray<double> row_expected = {{1., 2., 3.}, {1., 2., 3.}};
+        xarray<double> col_expected = {{1., 1., 1.}, {2., 2., 2.}};
+        EXPECT_EQ(r, row_expected);
+        EXPECT_EQ(c, col_expected);
+    }
 }
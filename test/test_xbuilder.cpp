@@ -11,6 +11,7 @@
 #define VS_SKIP_CONCATENATE_FIXED 1
 #endif
 
+#include <complex>
 #include <sstream>
 
 #include "xtensor/containers/xarray.hpp"
@@ -532,6 +533,69 @@ namespace xt
         EXPECT_EQ(c2, e2);
     }
 
+    namespace
+    {
+        // Evaluates a builder in containers of both layouts
+        template <class G>
+        void check_blocks(const G& gen)
+        {
+            xarray<typename G::value_type> row = gen;
+            xarray<typename G::value_type, layout_type::column_major> col = gen;
+            EXPECT_EQ(row, gen);
+            EXPECT_EQ(col, gen);
+        }
+    }
+
+    TEST(xbuilder, concatenate_blocks)
+    {
+        xarray<double> a = arange<double>(2 * 3 * 4).reshape({2, 3, 4});
+        xarray<double> b = arange<double>(100, 100 + 2 * 5 * 4).reshape({2, 5, 4});
+        xarray<double, layout_type::column_major> bc = b;
+        xarray<double> c = arange<double>(-30, 0).reshape({2, 1, 15});
+        check_blocks(concatenate(xtuple(a, b, a), 1));
+        check_blocks(concatenate(xtuple(a, bc), 1));
+        check_blocks(concatenate(xtuple(a, b + 1.), 1));
+        check_blocks(concatenate(xtuple(a, a, a), 0));
+        check_blocks(concatenate(xtuple(a, a), 2));
+        xarray<double> d = arange<double>(30).reshape({15, 1, 2});
+        check_blocks(concatenate(xtuple(c, transpose(d)), 2));
+
+        // Blocks longer than a work unit and rows shorter than a work unit
+        xarray<int> l0 = arange<int>(300 * 70).reshape({300, 70});
+        xarray<double> l1 = arange<double>(200 * 70).reshape({200, 70});
+        check_blocks(concatenate(xtuple(l0, l1)));
+        check_blocks(concatenate(xtuple(l1, l1), 1));
+
+        // Empty operands
+        xarray<double> e = xarray<double>::from_shape({2, 0, 4});
+        check_blocks(concatenate(xtuple(e, a, e), 1));
+        check_blocks(concatenate(xtuple(e, e), 1));
+
+        xtensor<double, 3> t = concatenate(xtuple(a, b), 1);
+        EXPECT_EQ(t, concatenate(xtuple(a, b), 1));
+    }
+
+    TEST(xbuilder, stack_blocks)
+    {
+        xarray<double> a = arange<double>(2 * 3 * 4).reshape({2, 3, 4});
+        xarray<double, layout_type::column_major> ac = a + 50.;
+        for (std::size_t axis = 0; axis < 4; ++axis)
+        {
+            check_blocks(stack(xtuple(a, ac, a * 2.), axis));
+        }
+
+        xarray<int> v0 = {1, 2, 3};
+        xarray<int> v1 = {4, 5, 6};
+        check_blocks(vstack(xtuple(v0, v1, v0)));
+        check_blocks(hstack(xtuple(v0, v1)));
+        check_blocks(vstack(xtuple(a, a)));
+        check_blocks(hstack(xtuple(a, ac)));
+
+        xtensor<int, 2> vt = vstack(xtuple(v0, v1));
+        xtensor<int, 2> expected = {{1, 2, 3}, {4, 5, 6}};
+        EXPECT_EQ(vt, expected);
+    }
+
     TEST(xbuilder, meshgrid)
     {
         auto mesh = meshgrid(linspace<double>(0.0, 1.0, 3), linspace<double>(0.0, 1.0, 2));
@@ -705,5 +769,12 @@ namespace xt
         EXPECT_TRUE(b);
         b = std::is_same<decltype(ed3), xarray<double>>::value;
         EXPECT_TRUE(b);
+
+        auto ec = empty<std::complex<double>>(std::vector<std::size_t>({3, 3}));
+        EXPECT_EQ(ec.size(), std::size_t(9));
+        auto ecl = empty_like(ec);
+        EXPECT_EQ(ecl.shape(), ec.shape());
+        auto fcl = full_like(ec, std::complex<double>(1., 2.));
+        EXPECT_EQ(fcl(2, 1), std::complex<double>(1., 2.));
     }
 }
@@ -0,0 +1,190 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay and Wolf Vollprecht          *
+ * Copyright (c) QuantStack                                                 *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include <cstddef>
+#include <vector>
+
+#include "xtensor/containers/xarray.hpp"
+#include "xtensor/containers/xtensor.hpp"
+#include "xtensor/core/xmath.hpp"
+#include "xtensor/generators/xbuilder.hpp"
+#include "xtensor/misc/xconvolve.hpp"
+#include "xtensor/misc/xmanipulation.hpp"
+#include "xtensor/misc/xpad.hpp"
+#include "xtensor/views/xview.hpp"
+
+#include "test_common_macros.hpp"
+
+namespace xt
+{
+    namespace
+    {
+        const std::vector<pad_mode> all_modes = {
+            pad_mode::constant,
+            pad_mode::symmetric,
+            pad_mode::reflect,
+            pad_mode::wrap,
+            pad_mode::periodic,
+            pad_mode::edge
+        };
+
+        // Straightforward correlation reading out of bounds samples through
+        // xt::pad, used as a reference.
+        template <class T>
+        xarray<T> reference_correlate(const xarray<T>& e, const xarray<T>& k, pad_mode mode, T cval)
+        {
+            std::vector<std::vector<std::size_t>> pad_width(e.dimension());
+            for (std::size_t d = 0; d < e.dimension(); ++d)
+            {
+                pad_width[d] = {k.shape()[d] / 2, k.shape()[d] - 1 - k.shape()[d] / 2};
+            }
+            xarray<T> p = pad(e, pad_width, mode, cval);
+            xarray<T> res = zeros<T>(e.shape());
+            for (std::size_t i = 0; i < res.size(); ++i)
+            {
+                auto oi = unravel_index(i, res.shape());
+                T acc = T(0);
+                for (std::size_t j = 0; j < k.size(); ++j)
+                {
+                    auto kj = unravel_index(j, k.shape());
+                    std::vector<std::size_t> pi(oi.size());
+                    for (std::size_t d = 0; d < oi.size(); ++d)
+                    {
+                        pi[d] = oi[d] + kj[d];
+                    }
+                    acc += k.element(kj.cbegin(), kj.cend()) * p.element(pi.cbegin(), pi.cend());
+                }
+                res.element(oi.cbegin(), oi.cend()) = acc;
+            }
+            return res;
+        }
+
+        xarray<double> make_input(const std::vector<std::size_t>& shape)
+        {
+            const auto i = arange<double>(static_cast<double>(compute_size(shape))).reshape(shape);
+            return fmod(i * 7., 11.) - 4.5;
+        }
+    }
+
+    TEST(xconvolve, correlate_2d_modes)
+    {
+        xarray<double> a = make_input({5, 7});
+        xarray<double> k = {{1., -2., 0.5}, {0.25, 3., -1.}};
+        for (auto mode : all_modes)
+        {
+            auto res = correlate_nd(a, k, mode, 1.5);
+            auto expected = reference_correlate(a, k, mode, 1.5);
+            EXPECT_EQ(res.shape(), a.shape());
+            EXPECT_TRUE(allclose(res, expected));
+        }
+    }
+
+    TEST(xconvolve, correlate_3d_modes)
+    {
+        xarray<double> a = make_input({4, 3, 6});
+        xarray<double> k = make_input({3, 2, 4});
+        for (auto mode : all_modes)
+        {
+            auto res = correlate_nd(a, k, mode);
+            auto expected = reference_correlate(a, k, mode, 0.);
+            EXPECT_TRUE(allclose(res, expected));
+        }
+    }
+
+    TEST(xconvolve, convolve_is_flipped_correlation)
+    {
+        xarray<double> a = make_input({6, 5});
+        xarray<double> k = {{1., 2., 3.}, {4., 5., 6.}, {7., 8., 10.}};
+        xarray<double> flipped = flip(flip(k, 0), 1);
+        for (auto mode : all_modes)
+        {
+            EXPECT_TRUE(allclose(convolve_nd(a, k, mode), correlate_nd(a, flipped, mode)));
+        }
+
+        // Even lengths shift the origin like scipy.ndimage.convolve
+        xarray<double> x = {1., 2., 3., 4.};
+        xarray<double> v = {1., 10.};
+        xarray<double> expected = {12., 23., 34., 40.};
+        EXPECT_EQ(convolve_nd(x, v), expected);
+    }
+
+    TEST(xconvolve, separable_kernel)
+    {
+        xarray<double> a = make_input({9, 8});
+        xarray<double> f0 = {1., 2., 1.};
+        xarray<double> f1 = {-1., 0., 1., 0.5};
+        xarray<double> k = view(f0, all(), newaxis()) * view(f1, newaxis(), all());
+        for (auto mode : all_modes)
+        {
+            // rank-1 kernels are detected and computed with 1-D passes
+            auto res = correlate_nd(a, k, mode, 2.);
+            EXPECT_TRUE(allclose(res, reference_correlate(a, k, mode, 2.)));
+
+            auto sep = convolve_separable(a, std::vector<xarray<double>>{f0, f1}, mode, 2.);
+            EXPECT_TRUE(allclose(sep, convolve_nd(a, k, mode, 2.)));
+        }
+    }
+
+    TEST(xconvolve, separable_3d)
+    {
+        xarray<double> a = make_input({5, 6, 7});
+        std::vector<xtensor<double, 1>> kernels = {{0.5, 1.}, {1., -1., 2.}, {0.25, 0.5, 0.25}};
+        xarray<double> k = xarray<double>::from_shape({2, 3, 3});
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                for (std::size_t l = 0; l < 3; ++l)
+                {
+                    k(i, j, l) = kernels[0](i) * kernels[1](j) * kernels[2](l);
+                }
+            }
+        }
+        for (auto mode : all_modes)
+        {
+            EXPECT_TRUE(allclose(convolve_separable(a, kernels, mode, -1.), convolve_nd(a, k, mode, -1.)));
+        }
+    }
+
+    TEST(xconvolve, wide_rows)
+    {
+        // rows longer than one tile
+        xarray<double> a = make_input({3, 1100});
+        xarray<double> k = {{1., 0., -1.}, {2., 1., 0.}};
+        auto res = correlate_nd(a, k, pad_mode::reflect);
+        EXPECT_TRUE(allclose(res, reference_correlate(a, k, pad_mode::reflect, 0.)));
+    }
+
+    TEST(xconvolve, types)
+    {
+        xtensor<int, 2> a = {{1, 2, 3}, {4, 5, 6}};
+        xtensor<int, 2> k = {{0, 1, 0}, {1, 1, 1}, {0, 1, 0}};
+        auto res = convolve_nd(a, k, pad_mode::edge);
+        bool same_type = std::is_same<decltype(res), xtensor<int, 2>>::value;
+        EXPECT_TRUE(same_type);
+        xtensor<int, 2> expected = {{9, 13, 17}, {18, 22, 26}};
+        EXPECT_EQ(res, expected);
+
+        xtensor<double, 1> kd = {0.5, 0.5};
+        xtensor<double, 1> x = {2., 4., 6.};
+        auto resd = correlate_nd(x, kd, pad_mode::wrap);
+        xtensor<double, 1> expectedd = {4., 3., 5.};
+        EXPECT_EQ(resd, expectedd);
+    }
+
+    TEST(xconvolve, errors)
+    {
+        xarray<double> a = make_input({3, 3});
+        xarray<double> k = {1., 2.};
+        XT_EXPECT_ANY_THROW(correlate_nd(a, k));
+        xarray<double> empty_kernel = xarray<double>::from_shape({0, 2});
+        XT_EXPECT_ANY_THROW(correlate_nd(a, empty_kernel));
+        XT_EXPECT_ANY_THROW(convolve_separable(a, std::vector<xarray<double>>{k}));
+    }
+}
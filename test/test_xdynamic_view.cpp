@@ -265,4 +265,71 @@ namespace xt
         EXPECT_EQ(x, res);
     }
 
+    TEST(xdynamic_view, strided)
+    {
+        using namespace placeholders;
+        xarray<double> a = arange<double>(4 * 5 * 6).reshape({4, 5, 6});
+        const xdynamic_slice_vector slices = {range(1, 4), 2, newaxis(), range(_, _, -2)};
+        const xstrided_slice_vector strided_slices = {range(1, 4), 2, newaxis(), range(_, _, -2)};
+
+        auto dv = dynamic_view(a, slices);
+        auto sv = strided_view(a, strided_slices);
+        EXPECT_TRUE(dv.is_strided());
+        EXPECT_FALSE(dynamic_view(a, {keep(0, 2), all()}).is_strided());
+        EXPECT_EQ(dv.shape(), sv.shape());
+        EXPECT_EQ(dv(2, 0, 1), sv(2, 0, 1));
+        EXPECT_EQ(dv.unchecked(1, 0, 2), sv(1, 0, 2));
+        EXPECT_EQ(dv, sv);
+
+        // Evaluation in both layouts and through an expression
+        xarray<double> r = dv;
+        EXPECT_EQ(r, sv);
+        xarray<double, layout_type::column_major> c = dv;
+        EXPECT_EQ(c, sv);
+        xarray<double> f = dv + 1.;
+        EXPECT_EQ(f, sv + 1.);
+        const auto& ca = a;
+        xarray<double> cr = dynamic_view(ca, slices);
+        EXPECT_EQ(cr, sv);
+        xarray<double> fr = dynamic_view(a * 2., slices);
+        EXPECT_EQ(fr, strided_view(a * 2., strided_slices));
+
+        // Assignment to the view
+        xarray<double> b = a;
+        xarray<double> rhs = arange<double>(3 * 3).reshape({3, 1, 3});
+        dynamic_view(b, slices) = rhs;
+        strided_view(a, strided_slices) = rhs;
+        EXPECT_EQ(b, a);
+
+        noalias(dynamic_view(b, slices)) = rhs * 3.;
+        strided_view(a, strided_slices) = rhs * 3.;
+        EXPECT_EQ(b, a);
+
+        dynamic_view(b, slices) += rhs;
+        strided_view(a, strided_slices) += rhs;
+        EXPECT_EQ(b, a);
+
+        noalias(dynamic_view(b, slices)) -= rhs;
+        strided_view(a, strided_slices) -= rhs;
+        EXPECT_EQ(b, a);
+
+        dynamic_view(b, slices) *= 2.;
+        strided_view(a, strided_slices) *= 2.;
+        EXPECT_EQ(b, a);
+
+        dynamic_view(b, slices) = 7.;
+        EXPECT_TRUE(all(equal(strided_view(b, strided_slices), 7.)));
+        dynamic_view(b, {all(), 0, all()}).fill(-1.);
+        EXPECT_TRUE(all(equal(view(b, all(), 0, all()), -1.)));
+        dynamic_view(b, {keep(0, 2), all(), all()}).fill(-2.);
+        EXPECT_TRUE(all(equal(view(b, keep(0, 2), all(), all()), -2.)));
+
+        // Contiguous and fully indexed views
+        auto row = dynamic_view(b, {1, 2});
+        EXPECT_EQ(row.dimension(), std::size_t(1));
+        row = arange<double>(6);
+        EXPECT_EQ(b(1, 2, 4), 4.);
+        auto elem = dynamic_view(b, {3, 4, 5});
+        EXPECT_EQ(elem(), b(3, 4, 5));
+    }
 }
@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <complex>
+#include <vector>
+
 #include "xtensor/containers/xarray.hpp"
 #include "xtensor/misc/xfft.hpp"
 
@@ -5,6 +9,269 @@
 
 namespace xt
 {
+    namespace
+    {
+        std::vector<std::complex<double>> naive_dft(const std::vector<std::complex<double>>& x)
+        {
+            const std::size_t n = x.size();
+            std::vector<std::complex<double>> res(n);
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                for (std::size_t j = 0; j < n; ++j)
+                {
+                    const double angle = -2. * numeric_constants<double>::PI * double(j * k % n) / double(n);
+                    res[k] += x[j] * std::complex<double>(std::cos(angle), std::sin(angle));
+                }
+            }
+            return res;
+        }
+
+        std::vector<std::complex<double>> make_signal(std::size_t n)
+        {
+            std::vector<std::complex<double>> x(n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                x[i] = {std::sin(0.3 * double(i)) + 0.1 * double(i % 7), std::cos(1.7 * double(i))};
+            }
+            return x;
+        }
+    }
+
+    TEST(xfft, plan_matches_dft)
+    {
+        for (std::size_t n : {1, 2, 4, 8, 64, 256})
+        {
+            auto x = make_signal(n);
+            auto expected = naive_dft(x);
+            auto plan = xt::fft::get_plan<double>(n);
+            EXPECT_EQ(plan->size(), n);
+            plan->forward(x.data());
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                EXPECT_LE(std::abs(x[k] - expected[k]), 1e-9 * double(n));
+            }
+        }
+    }
+
+    TEST(xfft, plan_backward)
+    {
+        const std::size_t n = 128;
+        auto x = make_signal(n);
+        auto y = x;
+        auto plan = xt::fft::get_plan<double>(n);
+        plan->forward(y.data());
+        plan->backward(y.data());
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            EXPECT_LE(std::abs(y[k] / double(n) - x[k]), 1e-12);
+        }
+    }
+
+    TEST(xfft, plan_mixed_radix)
+    {
+        // radix 3, 5, 7, 4 * 2 * 3, generic 11 and 13, and Bluestein for 67, 101 and 2 * 67
+        for (std::size_t n : {3, 5, 6, 7, 12, 15, 24, 35, 49, 100, 11, 26, 143, 1000, 1536, 2400, 67, 101, 134})
+        {
+            auto x = make_signal(n);
+            auto expected = naive_dft(x);
+            auto plan = xt::fft::get_plan<double>(n);
+            plan->forward(x.data());
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                EXPECT_LE(std::abs(x[k] - expected[k]), 1e-9 * double(n));
+            }
+        }
+    }
+
+    TEST(xfft, plan_mixed_radix_backward)
+    {
+        for (std::size_t n : {30, 77, 1000, 101})
+        {
+            auto x = make_signal(n);
+            auto y = x;
+            auto plan = xt::fft::get_plan<double>(n);
+            plan->forward(y.data());
+            plan->backward(y.data());
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                EXPECT_LE(std::abs(y[k] / double(n) - x[k]), 1e-11);
+            }
+        }
+    }
+
+    TEST(xfft, rfft_plan)
+    {
+        for (std::size_t n : {1, 2, 3, 4, 15, 16, 30, 1000, 101})
+        {
+            auto x = make_signal(n);
+            std::vector<double> r(n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                r[i] = x[i].real();
+                x[i] = r[i];
+            }
+            auto expected = naive_dft(x);
+            auto plan = xt::fft::get_rfft_plan<double>(n);
+            EXPECT_EQ(plan->spectrum_size(), n / 2 + 1);
+            std::vector<std::complex<double>> spectrum(plan->spectrum_size());
+            plan->forward(r.data(), spectrum.data());
+            for (std::size_t k = 0; k < spectrum.size(); ++k)
+            {
+                EXPECT_LE(std::abs(spectrum[k] - expected[k]), 1e-9 * double(n));
+            }
+            std::vector<double> back(n);
+            plan->backward(spectrum.data(), back.data());
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                EXPECT_LE(std::abs(back[i] / double(n) - r[i]), 1e-11);
+            }
+        }
+    }
+
+    TEST(xfft, rfft)
+    {
+        xt::xarray<double> a = xt::xarray<double>::from_shape({6, 4});
+        auto x = make_signal(24);
+        std::transform(
+            x.begin(),
+            x.end(),
+            a.begin(),
+            [](const auto& v)
+            {
+                return v.real();
+            }
+        );
+
+        auto res1 = xt::fft::rfft(a);
+        auto full1 = xt::fft::fft(a);
+        EXPECT_EQ(res1.shape(0), std::size_t(6));
+        EXPECT_EQ(res1.shape(1), std::size_t(3));
+        EXPECT_LE(xt::amax(xt::abs(res1 - xt::view(full1, xt::all(), xt::range(0, 3))))(), 1e-12);
+
+        auto res0 = xt::fft::rfft(a, 0);
+        auto full0 = xt::fft::fft(a, 0);
+        EXPECT_EQ(res0.shape(0), std::size_t(4));
+        EXPECT_LE(xt::amax(xt::abs(res0 - xt::view(full0, xt::range(0, 4), xt::all())))(), 1e-12);
+
+        xt::xarray<double> back0 = xt::fft::irfft(res0, 6, 0) / 6.;
+        EXPECT_LE(xt::amax(xt::abs(back0 - a))(), 1e-12);
+        xt::xarray<double> back1 = xt::fft::irfft(res1) / 4.;
+        EXPECT_LE(xt::amax(xt::abs(back1 - a))(), 1e-12);
+        // odd length output from the same bins
+        auto odd = xt::fft::irfft(xt::fft::rfft(xt::view(a, xt::range(0, 5), xt::all()), 0), 5, 0) / 5.;
+        EXPECT_LE(xt::amax(xt::abs(odd - xt::view(a, xt::range(0, 5), xt::all())))(), 1e-12);
+    }
+
+    TEST(xfft, irfft_padded_lanes)
+    {
+        // n = 11 needs 6 bins, only 4 are given: every lane goes through the padded path
+        xt::xarray<std::complex<double>> bins = xt::xarray<std::complex<double>>::from_shape({4, 150});
+        auto x = make_signal(bins.size());
+        std::copy(x.begin(), x.end(), bins.begin());
+        xt::xarray<std::complex<double>> full = xt::zeros<std::complex<double>>({6, 150});
+        xt::view(full, xt::range(0, 4), xt::all()) = bins;
+
+        auto res0 = xt::fft::irfft(bins, 11, 0);
+        auto expected0 = xt::fft::irfft(full, 11, 0);
+        EXPECT_EQ(res0.shape(0), std::size_t(11));
+        EXPECT_LE(xt::amax(xt::abs(res0 - expected0))(), 1e-12);
+
+        xt::xarray<std::complex<double>> tbins = xt::transpose(bins);
+        xt::xarray<std::complex<double>> tfull = xt::transpose(full);
+        auto res1 = xt::fft::irfft(tbins, 11);
+        auto expected1 = xt::fft::irfft(tfull, 11);
+        EXPECT_EQ(res1.shape(1), std::size_t(11));
+        EXPECT_LE(xt::amax(xt::abs(res1 - expected1))(), 1e-12);
+        EXPECT_LE(xt::amax(xt::abs(res1 - xt::transpose(res0)))(), 1e-12);
+    }
+
+    TEST(xfft, fft_blocked_lanes)
+    {
+        // 40 lanes along axis 0, not a multiple of the lane block
+        xt::xarray<std::complex<double>> a = xt::xarray<std::complex<double>>::from_shape({12, 5, 8});
+        auto x = make_signal(a.size());
+        std::copy(x.begin(), x.end(), a.begin());
+        auto res = xt::fft::fft(a, 0);
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            for (std::size_t j = 0; j < 8; ++j)
+            {
+                std::vector<std::complex<double>> lane(12);
+                for (std::size_t k = 0; k < 12; ++k)
+                {
+                    lane[k] = a(k, i, j);
+                }
+                auto expected = naive_dft(lane);
+                for (std::size_t k = 0; k < 12; ++k)
+                {
+                    EXPECT_LE(std::abs(res(k, i, j) - expected[k]), 1e-9);
+                }
+            }
+        }
+    }
+
+    TEST(xfft, fftn)
+    {
+        xt::xarray<std::complex<double>> a = xt::xarray<std::complex<double>>::from_shape({6, 5, 8});
+        auto x = make_signal(a.size());
+        std::copy(x.begin(), x.end(), a.begin());
+
+        auto all = xt::fft::fftn(a);
+        auto expected_all = xt::fft::fft(xt::fft::fft(xt::fft::fft(a, 0), 1), 2);
+        EXPECT_LE(xt::amax(xt::abs(all - expected_all))(), 1e-9);
+
+        auto two = xt::fft::fftn(a, {0, 2});
+        auto expected_two = xt::fft::fft(xt::fft::fft(a, 2), 0);
+        EXPECT_LE(xt::amax(xt::abs(two - expected_two))(), 1e-9);
+
+        auto last_two = xt::fft::fft2(a);
+        auto expected_last_two = xt::fft::fft(xt::fft::fft(a, -1), -2);
+        EXPECT_LE(xt::amax(xt::abs(last_two - expected_last_two))(), 1e-9);
+
+        xt::xarray<std::complex<double>> back = xt::fft::ifftn(all) / double(a.size());
+        EXPECT_LE(xt::amax(xt::abs(back - a))(), 1e-12);
+        xt::xarray<std::complex<double>> back2 = xt::fft::ifft2(last_two) / 40.;
+        EXPECT_LE(xt::amax(xt::abs(back2 - a))(), 1e-12);
+
+        xt::xarray<double> r = xt::real(a);
+        auto real_in = xt::fft::fftn(r, {1});
+        auto expected_real = xt::fft::fft(r, 1);
+        EXPECT_LE(xt::amax(xt::abs(real_in - expected_real))(), 1e-12);
+    }
+
+    TEST(xfft, plan_cache)
+    {
+        auto p1 = xt::fft::get_plan<float>(32);
+        auto p2 = xt::fft::get_plan<float>(32);
+        EXPECT_EQ(p1.get(), p2.get());
+        xt::fft::clear_plan_cache<float>();
+        auto p3 = xt::fft::get_plan<float>(32);
+        EXPECT_NE(p1.get(), p3.get());
+        XT_EXPECT_ANY_THROW(xt::fft::fft_plan<float>(0));
+    }
+
+    TEST(xfft, fft_power_2_axis_0)
+    {
+        const std::size_t n = 16;
+        xt::xarray<std::complex<double>> a = xt::xarray<std::complex<double>>::from_shape({n, 3});
+        auto x = make_signal(n * 3);
+        std::copy(x.begin(), x.end(), a.begin());
+        auto res = xt::fft::fft(a, 0);
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            std::vector<std::complex<double>> col(n);
+            for (std::size_t r = 0; r < n; ++r)
+            {
+                col[r] = a(r, c);
+            }
+            auto expected = naive_dft(col);
+            for (std::size_t r = 0; r < n; ++r)
+            {
+                EXPECT_LE(std::abs(res(r, c) - expected[r]), 1e-9);
+            }
+        }
+    }
+
     TEST(xfft, fft_power_2)
     {
         size_t k = 2;
@@ -9,6 +9,7 @@
 
 #include <complex>
 #include <limits>
+#include <vector>
 
 // For some obscure reason xtensor.hpp need to be included first for Windows' Clangcl
 #include "xtensor/containers/xtensor.hpp"
@@ -73,6 +74,124 @@ namespace xt
         }
     }
 
+    TEST(xhistogram, histogram_large)
+    {
+        // several parallel tasks, values on and out of the edges
+        const std::size_t n = 100003;
+        xt::xtensor<double, 1> data = xt::xtensor<double, 1>::from_shape({n});
+        xt::xtensor<double, 1> weights = xt::xtensor<double, 1>::from_shape({n});
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            data(i) = static_cast<double>((i * 37) % 1201) / 100. - 1.;
+            weights(i) = static_cast<double>(i % 3);
+        }
+
+        xt::xtensor<double, 1> edges = {0., 0.5, 2., 2.25, 7., 10.};
+        xt::xtensor<double, 1> expected = xt::zeros<double>({edges.size() - 1});
+        xt::xtensor<double, 1> expected_uniform = xt::zeros<double>({std::size_t(4)});
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const double v = data(i);
+            for (std::size_t b = 0; b + 1 < edges.size(); ++b)
+            {
+                bool last = b + 2 == edges.size();
+                if (v >= edges(b) && (v < edges(b + 1) || (last && v == edges(b + 1))))
+                {
+                    expected(b) += weights(i);
+                }
+            }
+            if (v >= 0. && v <= 8.)
+            {
+                expected_uniform(std::min(static_cast<std::size_t>(v / 2.), std::size_t(3))) += weights(i);
+            }
+        }
+
+        xt::xtensor<double, 1> count = xt::histogram(data, edges, weights);
+        EXPECT_EQ(count, expected);
+
+        xt::xtensor<double, 1> count_uniform = xt::histogram(data, std::size_t(4), weights, 0., 8.);
+        EXPECT_EQ(count_uniform, expected_uniform);
+
+        xt::xtensor<double, 1> unweighted = xt::histogram(data, std::size_t(4), 0., 8.);
+        EXPECT_EQ(xt::sum(unweighted)(), static_cast<double>(xt::sum(data >= 0. && data <= 8.)()));
+
+        // the partial bins are added in task order, rounding does not depend on the scheduling
+        xt::xtensor<double, 1> fractional = 0.1 * weights + 1e-3 * data;
+        xt::xtensor<double, 1> first_run = xt::histogram(data, edges, fractional);
+        xt::xtensor<double, 1> second_run = xt::histogram(data, edges, fractional);
+        EXPECT_EQ(first_run, second_run);
+    }
+
+    TEST(xhistogram, histogram2d)
+    {
+        xt::xtensor<double, 1> x = {0., 0.5, 1., 1.5, 2., 2., 3.};
+        xt::xtensor<double, 1> y = {0., 1., 1., 2., 0., 2., 1.};
+        xt::xtensor<double, 1> x_edges = {0., 1., 2.};
+        xt::xtensor<double, 1> y_edges = {0., 1., 1.5, 2.};
+
+        // x = 3. is out of the edges, the last bins include their right edge
+        xt::xtensor<double, 2> count = xt::histogram2d(x, y, x_edges, y_edges);
+        xt::xtensor<double, 2> expected = {{1., 1., 0.}, {1., 1., 2.}};
+        EXPECT_EQ(count, expected);
+
+        xt::xtensor<double, 1> weights = {1., 2., 3., 4., 5., 6., 7.};
+        xt::xtensor<double, 2> wcount = xt::histogram2d(x, y, x_edges, y_edges, weights);
+        xt::xtensor<double, 2> wexpected = {{1., 2., 0.}, {5., 3., 10.}};
+        EXPECT_EQ(wcount, wexpected);
+
+        auto density = xt::histogram2d(x, y, x_edges, y_edges, true);
+        xt::xtensor<double, 2> volume = {{1., 0.5, 0.5}, {1., 0.5, 0.5}};
+        EXPECT_TRUE(xt::allclose(xt::sum(density * volume)(), 1.));
+
+        xt::xtensor<double, 2> ranged = xt::histogram2d(x, y, std::size_t(3));
+        EXPECT_EQ(ranged.shape()[0], std::size_t(3));
+        EXPECT_EQ(xt::sum(ranged)(), 7.);
+        EXPECT_EQ(ranged(0, 0), 1.);
+    }
+
+    TEST(xhistogram, histogramdd)
+    {
+        const std::size_t n = 50000;
+        xt::xtensor<double, 2> data = xt::xtensor<double, 2>::from_shape({n, 3});
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            data(i, 0) = static_cast<double>(i % 7);
+            data(i, 1) = static_cast<double>((i * 13) % 5) - 1.;
+            data(i, 2) = static_cast<double>(i % 4) / 4.;
+        }
+
+        std::vector<xt::xtensor<double, 1>> edges = {{0., 2., 6.}, {0., 1., 3.}, {0., 0.3, 0.75}};
+        xt::xarray<double> count = xt::histogramdd(data, edges);
+        EXPECT_EQ(count.shape(), (std::vector<std::size_t>{2, 2, 2}));
+
+        xt::xarray<double> expected = xt::zeros<double>({2, 2, 2});
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            std::vector<std::size_t> idx(3);
+            bool inside = true;
+            for (std::size_t d = 0; d < 3; ++d)
+            {
+                const auto& e = edges[d];
+                const double v = data(i, d);
+                inside = inside && v >= e(0) && v <= e(2);
+                idx[d] = v < e(1) ? 0 : 1;
+            }
+            if (inside)
+            {
+                expected.element(idx.cbegin(), idx.cend()) += 1.;
+            }
+        }
+        EXPECT_EQ(count, expected);
+
+        xt::xarray<double> ranged = xt::histogramdd(data, {7, 5, 4});
+        EXPECT_EQ(ranged.shape(), (std::vector<std::size_t>{7, 5, 4}));
+        EXPECT_EQ(xt::sum(ranged)(), static_cast<double>(n));
+
+        xt::xtensor<double, 1> weights = xt::ones<double>({n}) * 2.;
+        xt::xarray<double> weighted = xt::histogramdd(data, edges, weights);
+        EXPECT_EQ(weighted, expected * 2.);
+    }
+
     TEST(xhistogram, bincount)
     {
         xtensor<int, 1> data = {1, 2, 3, 1, 1, 1, 1, 2, 3, 2, 3, 3, 3, 3};
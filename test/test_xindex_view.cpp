@@ -178,6 +178,129 @@ namespace xt
         EXPECT_EQ(resr, expr);
     }
 
+    TEST(xindex_view, linear_gather)
+    {
+        // flat integer indices are gathered from the storage
+        xarray<double> a = {{1., 2., 3.}, {4., 5., 6.}};
+        std::vector<std::size_t> idx = {5, 0, 2, 2, 4};
+        auto v = index_view(a, idx);
+        EXPECT_EQ(v.layout(), layout_type::row_major);
+        EXPECT_FALSE(v.is_contiguous());
+        EXPECT_TRUE(v.linear_gather());
+        EXPECT_EQ(v.data_element(0), 6.);
+        EXPECT_EQ(v.data_element(3), 3.);
+        EXPECT_EQ(v.template load_simd<xt_simd::unaligned_mode>(1), v(1));
+
+        xarray<double> b = {10., 20., 30., 40., 50.};
+        xarray<double> res = v * 2. + b;
+        xarray<double> expected = {22., 22., 36., 46., 60.};
+        EXPECT_EQ(res, expected);
+
+        xtensor<double, 1> res_tensor = v;
+        xtensor<double, 1> expected_tensor = {6., 1., 3., 3., 5.};
+        EXPECT_EQ(res_tensor, expected_tensor);
+
+        // underlying strided view
+        auto col = view(a, all(), 1);
+        std::vector<std::size_t> col_idx = {1, 0};
+        xarray<double> col_res = index_view(col, col_idx);
+        xarray<double> col_expected = {5., 2.};
+        EXPECT_EQ(col_res, col_expected);
+
+        // filter of a 1-D expression
+        xtensor<int, 1> c = {3, -1, 4, -1, 5, -9, 2, 6};
+        auto f = filter(c, c > 0);
+        EXPECT_FALSE(f.is_contiguous());
+        EXPECT_TRUE(f.linear_gather());
+        EXPECT_TRUE(detail::linear_dynamic_layout(c, f + 1));
+        xtensor<int, 1> f_res = f + 1;
+        xtensor<int, 1> f_expected = {4, 5, 6, 3, 7};
+        EXPECT_EQ(f_res, f_expected);
+
+        // expressions without data interface are not gathered
+        auto g = index_view(a + 1., idx);
+        EXPECT_FALSE(g.linear_gather());
+        EXPECT_EQ(g.layout(), layout_type::dynamic);
+        xarray<double> g_res = g;
+        EXPECT_EQ(g_res, expected_tensor + 1.);
+    }
+
+    TEST(xindex_view, extract)
+    {
+        xarray<int> a = {{{1, 3}, {2, 4}}, {{5, 7}, {6, 8}}};
+        xarray<bool> cond = {{{true, true}, {false, false}}, {{true, true}, {false, false}}};
+
+        xtensor<int, 1> resr = extract(a, cond);
+        xtensor<int, 1> expr = {1, 3, 5, 7};
+        EXPECT_EQ(resr, expr);
+
+        xtensor<int, 1> resc = extract<layout_type::column_major>(a, cond);
+        xtensor<int, 1> expc = {1, 5, 3, 7};
+        EXPECT_EQ(resc, expc);
+
+        // lazy condition and strided expression
+        auto v = view(a, all(), 1, all());
+        xtensor<int, 1> resv = extract(v, equal(v % 2, 0));
+        xtensor<int, 1> expv = {2, 4, 6, 8};
+        EXPECT_EQ(resv, expv);
+
+        EXPECT_EQ(extract(a, a > 10).size(), std::size_t(0));
+        XT_EXPECT_ANY_THROW(extract(a, xarray<bool>{true, false}));
+    }
+
+    TEST(xindex_view, extract_large)
+    {
+        // spans several blocks, some of them fully selected
+        xarray<double> a = xt::random::rand<double>({37, 1000});
+        xarray<bool> cond = a > 0.3;
+        view(cond, range(5, 15), all()) = true;
+        view(cond, range(20, 30), all()) = false;
+
+        xarray<double> expected = filter(a, cond);
+        xtensor<double, 1> res = extract(a, cond);
+        EXPECT_EQ(res, expected);
+
+        xarray<double> expectedc = filter<layout_type::column_major>(a, cond);
+        xtensor<double, 1> resc = extract<layout_type::column_major>(a, cond);
+        EXPECT_EQ(resc, expectedc);
+    }
+
+    TEST(xindex_view, place)
+    {
+        xarray<double> a = {{1, 5, 3}, {4, 5, 6}};
+        place(a, a >= 5, xarray<double>{0, -1});
+        xarray<double> expected = {{1, 0, 3}, {4, -1, 0}};
+        EXPECT_EQ(a, expected);
+
+        xarray<int> b = {{1, 2}, {3, 4}};
+        place<layout_type::column_major>(b, b > 1, xarray<int>{10, 20, 30});
+        xarray<int> expectedc = {{1, 20}, {10, 30}};
+        EXPECT_EQ(b, expectedc);
+
+        // strided view
+        xarray<int> c = {{1, 2, 3}, {4, 5, 6}};
+        auto col = view(c, all(), 1);
+        place(col, col > 0, xarray<int>{7});
+        xarray<int> expectedv = {{1, 7, 3}, {4, 7, 6}};
+        EXPECT_EQ(c, expectedv);
+
+        place(c, c > 10, xarray<int>());
+        XT_EXPECT_ANY_THROW(place(c, c > 0, xarray<int>::from_shape({0})));
+    }
+
+    TEST(xindex_view, place_large)
+    {
+        xarray<double> a = xt::random::rand<double>({37, 1000});
+        xarray<bool> cond = a > 0.6;
+        view(cond, range(5, 15), all()) = true;
+        xarray<double> values = extract(a, cond) * 2.;
+
+        xarray<double> expected = a;
+        filter(expected, cond) = values;
+        place(a, cond, values);
+        EXPECT_EQ(a, expected);
+    }
+
     TEST(xindex_view, const_adapt_filter)
     {
         const std::vector<double> av({1, 2, 3, 4, 5, 6});
@@ -0,0 +1,205 @@
+/***************************************************************************
+ * Copyright (c) Johan Mabille, Sylvain Corlay and Wolf Vollprecht          *
+ * Copyright (c) QuantStack                                                 *
+ *                                                                          *
+ * Distributed under the terms of the BSD 3-Clause License.                 *
+ *                                                                          *
+ * The full license is in the file LICENSE, distributed with this software. *
+ ****************************************************************************/
+
+#include <string>
+#include <vector>
+
+#include "xtensor/containers/xarray.hpp"
+#include "xtensor/core/xmath.hpp"
+#include "xtensor/utils/xinstrumentation.hpp"
+#include "xtensor/views/xview.hpp"
+
+#include "test_common_macros.hpp"
+
+namespace xt
+{
+    using instrumentation::assigner_path;
+    using instrumentation::event;
+    using instrumentation::event_kind;
+
+    namespace
+    {
+        struct event_recorder
+        {
+            event_recorder()
+            {
+                instrumentation::set_callback(
+                    [this](const event& e)
+                    {
+                        events.push_back(e);
+                    }
+                );
+            }
+
+            ~event_recorder()
+            {
+                instrumentation::clear_callback();
+            }
+
+            std::size_t count(event_kind kind) const
+            {
+                std::size_t res = 0;
+                for (const auto& e : events)
+                {
+                    res += e.kind == kind ? 1u : 0u;
+                }
+                return res;
+            }
+
+            const event* last(event_kind kind) const
+            {
+                for (auto it = events.rbegin(); it != events.rend(); ++it)
+                {
+                    if (it->kind == kind)
+                    {
+                        return &*it;
+                    }
+                }
+                return nullptr;
+            }
+
+            std::vector<event> events;
+        };
+    }
+
+    TEST(instrumentation, to_string)
+    {
+        EXPECT_EQ(std::string(instrumentation::to_string(event_kind::allocation)), "allocation");
+        EXPECT_EQ(std::string(instrumentation::to_string(event_kind::reduction)), "reduction");
+        EXPECT_EQ(std::string(instrumentation::to_string(assigner_path::linear)), "linear");
+        EXPECT_EQ(std::string(instrumentation::to_string(assigner_path::transpose)), "transpose");
+        EXPECT_EQ(std::string(instrumentation::to_string(assigner_path::stepper)), "stepper");
+    }
+
+    TEST(instrumentation, scoped_event)
+    {
+        event_recorder rec;
+        {
+            instrumentation::scoped_event ev(event_kind::assignment, "manual", 3, 24);
+            ev.set_path(assigner_path::strided);
+        }
+        EXPECT_EQ(rec.events.size(), std::size_t(1));
+        EXPECT_EQ(rec.events[0].kind, event_kind::assignment);
+        EXPECT_EQ(std::string(rec.events[0].name), "manual");
+        EXPECT_EQ(rec.events[0].path, assigner_path::strided);
+        EXPECT_EQ(rec.events[0].elements, std::size_t(3));
+        EXPECT_EQ(rec.events[0].bytes, std::size_t(24));
+        EXPECT_GE(rec.events[0].elapsed.count(), 0);
+    }
+
+    TEST(instrumentation, no_callback)
+    {
+        {
+            instrumentation::scoped_event ev(event_kind::assignment, "manual");
+        }
+        EXPECT_FALSE(instrumentation::has_callback());
+    }
+
+#if defined(XTENSOR_INSTRUMENTATION)
+
+    TEST(instrumentation, allocation)
+    {
+        event_recorder rec;
+        {
+            xarray<double> a = xarray<double>::from_shape({4, 5});
+            a.fill(1.);
+        }
+        const event* alloc = rec.last(event_kind::allocation);
+        const event* dealloc = rec.last(event_kind::deallocation);
+        EXPECT_TRUE(alloc != nullptr);
+        EXPECT_TRUE(dealloc != nullptr);
+        EXPECT_EQ(alloc->elements, std::size_t(20));
+        EXPECT_EQ(alloc->bytes, 20 * sizeof(double));
+        EXPECT_EQ(dealloc->bytes, 20 * sizeof(double));
+    }
+
+    TEST(instrumentation, assign_linear)
+    {
+        xarray<double> a = {{1., 2., 3.}, {4., 5., 6.}};
+        xarray<double> b = {{1., 2., 3.}, {4., 5., 6.}};
+        xarray<double> res;
+
+        event_recorder rec;
+        res = a + b;
+
+        const event* resize = rec.last(event_kind::resize);
+        EXPECT_TRUE(resize != nullptr);
+        EXPECT_EQ(resize->elements, std::size_t(6));
+
+        const event* assign = rec.last(event_kind::assignment);
+        EXPECT_TRUE(assign != nullptr);
+        EXPECT_EQ(assign->path, assigner_path::linear);
+        EXPECT_EQ(assign->elements, std::size_t(6));
+        EXPECT_EQ(assign->bytes, 6 * sizeof(double));
+    }
+
+    TEST(instrumentation, assign_non_linear)
+    {
+        xarray<double> a = {{1., 2., 3.}, {4., 5., 6.}};
+        xarray<double> res = xarray<double>::from_shape({2, 2});
+
+        event_recorder rec;
+        res = view(a, all(), range(0, 2));
+
+        const event* assign = rec.last(event_kind::assignment);
+        EXPECT_TRUE(assign != nullptr);
+        EXPECT_NE(assign->path, assigner_path::linear);
+        EXPECT_NE(assign->path, assigner_path::none);
+        EXPECT_EQ(assign->elements, std::size_t(4));
+    }
+
+    TEST(instrumentation, reduction)
+    {
+        xarray<double> a = {{1., 2., 3.}, {4., 5., 6.}};
+
+        event_recorder rec;
+        xarray<double> s = sum(a, {1}, evaluation_strategy::immediate);
+        EXPECT_EQ(s(1), 15.);
+
+        EXPECT_EQ(rec.count(event_kind::reduction), std::size_t(1));
+        const event* red = rec.last(event_kind::reduction);
+        EXPECT_EQ(std::string(red->name), "reduce_immediate");
+        EXPECT_EQ(red->elements, std::size_t(6));
+    }
+
+    TEST(instrumentation, callback_is_not_reentrant)
+    {
+        std::size_t calls = 0;
+        instrumentation::set_callback(
+            [&calls](const event&)
+            {
+                ++calls;
+                xarray<double> tmp = xarray<double>::from_shape({8});
+                tmp.fill(0.);
+            }
+        );
+        {
+            xarray<double> a = xarray<double>::from_shape({3});
+            a.fill(2.);
+        }
+        instrumentation::clear_callback();
+        // one allocation and one deallocation, the containers of the callback are not reported
+        EXPECT_EQ(calls, std::size_t(2));
+    }
+
+#else
+
+    TEST(instrumentation, disabled)
+    {
+        xarray<double> a = {{1., 2., 3.}, {4., 5., 6.}};
+
+        event_recorder rec;
+        xarray<double> res = a + a;
+        xarray<double> s = sum(a, {1}, evaluation_strategy::immediate);
+        EXPECT_EQ(s(0), 6.);
+        EXPECT_TRUE(rec.events.empty());
+    }
+
+#endif
+}
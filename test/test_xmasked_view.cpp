@@ -9,6 +9,7 @@
 
 #include <sstream>
 
+#include "xtensor/generators/xbuilder.hpp"
 #include "xtensor/io/xio.hpp"
 #include "xtensor/optional/xoptional_assembly.hpp"
 #include "xtensor/views/xmasked_view.hpp"
@@ -240,6 +241,73 @@ namespace xt
         EXPECT_EQ(data, expected1);
     }
 
+    TEST(xmasked_view, select_assign)
+    {
+        xarray<double> data = {{1., -2., 3.}, {4., 5., -6.}, {7., 8., -9.}};
+        xarray<double> data2 = {{0.1, 0.2, 0.3}, {0.4, 0.5, 0.6}, {0.7, 0.8, 0.9}};
+        xarray<bool> mask = {{true, true, true}, {true, false, false}, {true, false, true}};
+
+        auto masked_data = masked_view(data, mask);
+        masked_data = data2 * 10. + 1.;
+        xarray<double> expected1 = {{2., 3., 4.}, {5., 5., -6.}, {8., 8., 10.}};
+        EXPECT_EQ(data, expected1);
+
+        // the data itself on the right hand side
+        masked_data = data * 2.;
+        xarray<double> expected2 = {{4., 6., 8.}, {10., 5., -6.}, {16., 8., 20.}};
+        EXPECT_EQ(data, expected2);
+
+        // overlapping memory and broadcasting
+        xarray<double> row = {1., 2., 3.};
+        masked_data = row;
+        xarray<double> expected3 = {{1., 2., 3.}, {1., 5., -6.}, {1., 8., 3.}};
+        EXPECT_EQ(data, expected3);
+        masked_data = view(data, keep(2, 1, 0), all());
+        xarray<double> expected4 = {{1., 8., 3.}, {1., 5., -6.}, {1., 8., 3.}};
+        EXPECT_EQ(data, expected4);
+        xarray<double> square = {{1., 2.}, {3., 4.}};
+        xarray<bool> square_mask = {{true, false}, {true, true}};
+        auto masked_square = masked_view(square, square_mask);
+        masked_square = transpose(square);
+        xarray<double> expected_square = {{1., 2.}, {2., 4.}};
+        EXPECT_EQ(square, expected_square);
+
+        // strided data
+        xarray<int> idata = {{1, 2, 3}, {4, 5, 6}};
+        xarray<bool> col_mask = {true, false};
+        auto masked_col = masked_view(view(idata, all(), 1), col_mask);
+        masked_col = xarray<int>{7, 8};
+        masked_col = 9 + xarray<int>{0, 0} * 0;
+        xarray<int> expected5 = {{1, 9, 3}, {4, 5, 6}};
+        EXPECT_EQ(idata, expected5);
+    }
+
+    TEST(xmasked_view, select_assign_large)
+    {
+        xarray<double> data = arange<double>(37 * 531).reshape({37, 531});
+        xarray<double> values = -data;
+        xarray<bool> mask = xarray<bool>::from_shape({37, 531});
+        for (std::size_t i = 0; i < mask.size(); ++i)
+        {
+            mask.flat(i) = (i * 7) % 3 == 0;
+        }
+
+        auto masked_data = masked_view(data, mask);
+        masked_data = values * 2.;
+        for (std::size_t i = 0; i < data.size(); ++i)
+        {
+            double expected = mask.flat(i) ? -2. * static_cast<double>(i) : static_cast<double>(i);
+            EXPECT_EQ(data.flat(i), expected);
+        }
+
+        masked_data = 0.5;
+        for (std::size_t i = 0; i < data.size(); ++i)
+        {
+            double expected = mask.flat(i) ? 0.5 : static_cast<double>(i);
+            EXPECT_EQ(data.flat(i), expected);
+        }
+    }
+
     TEST(xmasked_view, view)
     {
         xt::xarray<size_t> data = {{0, 1}, {2, 3}, {4, 5}};
@@ -9,6 +9,8 @@
 
 #include <complex>
 #include <limits>
+#include <utility>
+#include <vector>
 
 #include "xtensor/containers/xadapt.hpp"
 #include "xtensor/containers/xarray.hpp"
@@ -934,6 +936,125 @@ namespace xt
         EXPECT_EQ(result, expected);
     }
 
+    namespace
+    {
+        template <class T>
+        std::vector<T> naive_full_convolution(const std::vector<T>& a, const std::vector<T>& v)
+        {
+            std::vector<T> res(a.size() + v.size() - 1, T(0));
+            for (std::size_t i = 0; i < a.size(); ++i)
+            {
+                for (std::size_t j = 0; j < v.size(); ++j)
+                {
+                    res[i + j] += a[i] * v[j];
+                }
+            }
+            return res;
+        }
+
+        template <class T>
+        std::vector<T> convolution_signal(std::size_t n, double freq)
+        {
+            std::vector<T> res(n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                res[i] = T(std::sin(freq * double(i)) + 0.25 * double(i % 5));
+            }
+            return res;
+        }
+    }
+
+    TEST(xmath, convolve_same)
+    {
+        xt::xarray<double> x = {1.0, 2.0, 3.0};
+        xt::xarray<double> y = {0.0, 1.0, 0.5};
+        xt::xarray<double> expected = {1.0, 2.5, 4.0};
+
+        EXPECT_EQ(xt::convolve(x, y, xt::convolve_mode::same()), expected);
+
+        xt::xarray<double> z = {1.0, 2.0, 3.0, 4.0};
+        xt::xarray<double> w = {1.0, 1.0};
+        xt::xarray<double> expected_even = {1.0, 3.0, 5.0, 7.0};
+        EXPECT_EQ(xt::convolve(z, w, xt::convolve_mode::same()), expected_even);
+    }
+
+    TEST(xmath, convolve_valid_asymmetric)
+    {
+        xt::xarray<double> x = {1.0, 2.0, 3.0, 4.0};
+        xt::xarray<double> y = {1.0, 0.0, -1.0};
+        // numpy.convolve([1, 2, 3, 4], [1, 0, -1], 'valid')
+        xt::xarray<double> expected = {2.0, 2.0};
+
+        EXPECT_EQ(xt::convolve(x, y, xt::convolve_mode::valid()), expected);
+        EXPECT_EQ(xt::convolve(y, x, xt::convolve_mode::valid()), expected);
+    }
+
+    TEST(xmath, convolve_methods)
+    {
+        const std::vector<std::pair<std::size_t, std::size_t>> sizes = {{100, 7}, {500, 120}, {3000, 90}, {257, 257}};
+        const std::vector<xt::convolve_method> methods = {
+            xt::convolve_method::automatic,
+            xt::convolve_method::direct,
+            xt::convolve_method::fft,
+            xt::convolve_method::overlap_add
+        };
+        for (const auto& s : sizes)
+        {
+            auto a = convolution_signal<double>(s.first, 0.1);
+            auto v = convolution_signal<double>(s.second, 0.7);
+            auto full = naive_full_convolution(a, v);
+            auto ea = xt::adapt(a, {a.size()});
+            auto ev = xt::adapt(v, {v.size()});
+            const double tol = 1e-9 * double(s.second);
+            for (auto method : methods)
+            {
+                auto rfull = xt::convolve(ea, ev, xt::convolve_mode::full(), method);
+                EXPECT_EQ(rfull.size(), full.size());
+                for (std::size_t i = 0; i < full.size(); ++i)
+                {
+                    EXPECT_LE(std::abs(rfull(i) - full[i]), tol);
+                }
+
+                auto rsame = xt::convolve(ea, ev, xt::convolve_mode::same(), method);
+                EXPECT_EQ(rsame.size(), a.size());
+                for (std::size_t i = 0; i < a.size(); ++i)
+                {
+                    EXPECT_LE(std::abs(rsame(i) - full[i + (s.second - 1) / 2]), tol);
+                }
+
+                auto rvalid = xt::convolve(ev, ea, xt::convolve_mode::valid(), method);
+                EXPECT_EQ(rvalid.size(), a.size() - v.size() + 1);
+                for (std::size_t i = 0; i < rvalid.size(); ++i)
+                {
+                    EXPECT_LE(std::abs(rvalid(i) - full[i + s.second - 1]), tol);
+                }
+            }
+        }
+    }
+
+    TEST(xmath, convolve_complex_and_integer)
+    {
+        auto a = convolution_signal<std::complex<double>>(400, 0.2);
+        auto v = convolution_signal<std::complex<double>>(150, 0.9);
+        for (auto& x : v)
+        {
+            x *= std::complex<double>(0.5, 1.0);
+        }
+        auto full = naive_full_convolution(a, v);
+        auto res = xt::convolve(xt::adapt(a, {a.size()}), xt::adapt(v, {v.size()}), xt::convolve_mode::full(), xt::convolve_method::fft);
+        for (std::size_t i = 0; i < full.size(); ++i)
+        {
+            EXPECT_LE(std::abs(res(i) - full[i]), 1e-8);
+        }
+
+        // integer convolutions are always computed exactly
+        xt::xarray<int> x = xt::arange<int>(200);
+        xt::xarray<int> y = xt::ones<int>({100});
+        auto ires = xt::convolve(x, y, xt::convolve_mode::valid(), xt::convolve_method::fft);
+        EXPECT_EQ(ires(0), 4950);
+        EXPECT_EQ(ires(100), 14950);
+    }
+
     TEST(xmath, unwrap)
     {
         {
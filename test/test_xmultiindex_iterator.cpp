@@ -1,5 +1,8 @@
+#include <array>
+#include <cstddef>
 #include <vector>
 
+#include "xtensor/containers/xtensor.hpp"
 #include "xtensor/core/xmultiindex_iterator.hpp"
 
 #include "test_common.hpp"
@@ -36,6 +39,87 @@ namespace xt
             }
             EXPECT_TRUE(iter == end);
         }
+
+        TEST_CASE("range_for_each")
+        {
+            using index_type = std::array<std::size_t, 3>;
+            index_type first = {2, 3, 1};
+            index_type last = {4, 5, 8};
+            auto r = multiindex_range(first, last);
+            EXPECT_EQ(r.size(), std::size_t(2 * 2 * 7));
+
+            // Same order as the iterator
+            std::vector<index_type> indices;
+            r.for_each(
+                [&indices](const index_type& index)
+                {
+                    indices.push_back(index);
+                }
+            );
+            EXPECT_EQ(indices.size(), r.size());
+            std::size_t i = 0;
+            bool same = true;
+            for (auto it = r.begin(); it != r.end(); ++it, ++i)
+            {
+                same = same && i < indices.size() && *it == indices[i];
+            }
+            EXPECT_EQ(i, r.size());
+            EXPECT_TRUE(same);
+
+            std::size_t count = 0;
+            multiindex_range(index_type{1, 1, 1}, index_type{1, 4, 4}).for_each(
+                [&count](const index_type&)
+                {
+                    ++count;
+                }
+            );
+            EXPECT_EQ(count, std::size_t(0));
+
+            std::array<std::size_t, 0> scalar_shape = {};
+            multiindex_range(scalar_shape).for_each(
+                [&count](const std::array<std::size_t, 0>&)
+                {
+                    ++count;
+                }
+            );
+            EXPECT_EQ(count, std::size_t(1));
+        }
+
+        TEST_CASE("range_split")
+        {
+            auto r = multiindex_range(std::array<int, 2>{3, 4});
+            std::size_t total = 0;
+            for (std::size_t part = 0; part < 2; ++part)
+            {
+                total += r.split(part, 2).size();
+            }
+            EXPECT_EQ(total, r.size());
+            EXPECT_EQ(r.split(0, 2).last()[0], std::size_t(1));
+            EXPECT_EQ(r.split(1, 2).first()[0], std::size_t(1));
+            EXPECT_TRUE(r.split(0, 4).empty());
+        }
+
+        TEST_CASE("range_parallel_for_each")
+        {
+            // large enough to be shared between threads
+            xtensor<std::size_t, 4> a = xtensor<std::size_t, 4>::from_shape({40, 30, 8, 16});
+            a.fill(0);
+            auto r = multiindex_range(a.shape());
+            r.parallel_for_each(
+                [&a](const std::array<std::size_t, 4>& index)
+                {
+                    a[index] += 1 + index[3] + 10 * index[0];
+                }
+            );
+            bool same = true;
+            r.for_each(
+                [&a, &same](const std::array<std::size_t, 4>& index)
+                {
+                    same = same && a[index] == 1 + index[3] + 10 * index[0];
+                }
+            );
+            EXPECT_TRUE(same);
+        }
     }
 
 }
@@ -8,7 +8,9 @@
  ****************************************************************************/
 
 #include <complex>
+#include <cstddef>
 #include <limits>
+#include <vector>
 
 #include "xtensor/io/xio.hpp"
 #include "xtensor/misc/xpad.hpp"
@@ -17,6 +19,51 @@
 
 namespace xt
 {
+    namespace
+    {
+        // numpy.pad as an index mapping along each axis
+        std::ptrdiff_t pad_reference_index(pad_mode mode, std::ptrdiff_t p, std::ptrdiff_t before, std::ptrdiff_t n)
+        {
+            std::ptrdiff_t q = p - before;
+            if (mode == pad_mode::edge)
+            {
+                return std::min(std::max(q, std::ptrdiff_t(0)), n - 1);
+            }
+            if (mode == pad_mode::wrap || mode == pad_mode::periodic)
+            {
+                return ((q % n) + n) % n;
+            }
+            // successive mirrors of the axis
+            const std::ptrdiff_t edge = mode == pad_mode::symmetric ? 1 : 0;
+            while (q < 0 || q >= n)
+            {
+                q = q < 0 ? -q - edge : 2 * (n - 1) - q + edge;
+            }
+            return q;
+        }
+
+        template <class T>
+        void check_pad(const xarray<double>& a, const T& res, const std::vector<std::vector<std::size_t>>& pw, pad_mode mode)
+        {
+            for (std::size_t i = 0; i < res.size(); ++i)
+            {
+                auto idx = unravel_index(i, res.shape());
+                bool border = false;
+                std::vector<std::size_t> src(idx.size());
+                for (std::size_t d = 0; d < idx.size(); ++d)
+                {
+                    const auto p = static_cast<std::ptrdiff_t>(idx[d]);
+                    const auto before = static_cast<std::ptrdiff_t>(pw[d][0]);
+                    const auto n = static_cast<std::ptrdiff_t>(a.shape()[d]);
+                    border = border || p < before || p >= before + n;
+                    src[d] = static_cast<std::size_t>(pad_reference_index(mode, p, before, n));
+                }
+                const double expected = mode == pad_mode::constant && border ? -1. : a.element(src.cbegin(), src.cend());
+                EXPECT_EQ(res.element(idx.cbegin(), idx.cend()), expected);
+            }
+        }
+    }
+
     TEST(xpad, constant_a)
     {
         xt::xtensor<size_t, 2> a = {{0, 1, 2}, {3, 4, 5}};
@@ -361,4 +408,63 @@ namespace xt
         };
         EXPECT_EQ(m, expected);
     }
+
+    TEST(xpad, blocks)
+    {
+        xarray<double> a = xt::arange<double>(4 * 5 * 6).reshape({4, 5, 6});
+        xarray<double, layout_type::column_major> acm = a;
+        // pads wider than the axes continue the pattern of each mode
+        const std::vector<std::vector<std::size_t>> pw = {{2, 3}, {0, 4}, {7, 1}};
+        const std::vector<pad_mode> modes = {
+            pad_mode::constant,
+            pad_mode::symmetric,
+            pad_mode::reflect,
+            pad_mode::wrap,
+            pad_mode::periodic,
+            pad_mode::edge
+        };
+        for (auto mode : modes)
+        {
+            xarray<double> res = pad(a, pw, mode, -1.);
+            check_pad(a, res, pw, mode);
+
+            xarray<double, layout_type::column_major> rescm = pad(acm, pw, mode, -1.);
+            check_pad(a, rescm, pw, mode);
+
+            xarray<double> resv = pad(a + 0., pw, mode, -1.);
+            check_pad(a, resv, pw, mode);
+        }
+
+        xarray<double> empty = xarray<double>::from_shape({0, 3});
+        xarray<double> empty_pad = pad(empty, 1, pad_mode::constant, 2.);
+        xarray<double> empty_expected = xarray<double>::from_shape({2, 5});
+        empty_expected.fill(2.);
+        EXPECT_EQ(empty_pad, empty_expected);
+        XT_EXPECT_THROW(pad(empty, 1, pad_mode::wrap), std::runtime_error);
+    }
+
+    TEST(xpad, tile_blocks)
+    {
+        xarray<int> a = xt::arange<int>(3 * 2 * 5).reshape({3, 2, 5});
+        xarray<int, layout_type::column_major> acm = a;
+        const std::vector<std::size_t> reps = {2, 3, 2};
+
+        xarray<int> res = tile(a, reps);
+        xarray<int, layout_type::column_major> rescm = tile(acm, reps);
+        EXPECT_EQ(res.shape(), (xarray<int>::shape_type{6, 6, 10}));
+        for (std::size_t i = 0; i < res.shape()[0]; ++i)
+        {
+            for (std::size_t j = 0; j < res.shape()[1]; ++j)
+            {
+                for (std::size_t k = 0; k < res.shape()[2]; ++k)
+                {
+                    EXPECT_EQ(res(i, j, k), a(i % 3, j % 2, k % 5));
+                    EXPECT_EQ(rescm(i, j, k), a(i % 3, j % 2, k % 5));
+                }
+            }
+        }
+
+        xarray<int> none = tile(a, std::vector<std::size_t>{2, 0, 1});
+        EXPECT_EQ(none.size(), std::size_t(0));
+    }
 }
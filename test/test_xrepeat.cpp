@@ -7,7 +7,11 @@
  * The full license is in the file LICENSE, distributed with this software. *
  ****************************************************************************/
 
+#include <algorithm>
+#include <vector>
+
 #include "xtensor/containers/xarray.hpp"
+#include "xtensor/generators/xbuilder.hpp"
 #include "xtensor/io/xio.hpp"
 #include "xtensor/views/xrepeat.hpp"
 #include "xtensor/views/xview.hpp"
@@ -108,6 +112,38 @@ namespace xt
         EXPECT_EQ(b, res);
     }
 
+    TEST(xrepeat, assign_blocks)
+    {
+        xarray<int> a = xt::arange<int>(3 * 4 * 5).reshape({3, 4, 5});
+
+        auto v = xt::view(a, xt::all(), xt::all(), xt::range(0, 5, 2));
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            std::vector<std::size_t> repeats(a.shape()[axis], 2);
+            repeats[0] = 1;
+            repeats[1] = 3;
+
+            auto rep = xt::repeat(a, repeats, axis);
+            xarray<int> rm = rep;
+            EXPECT_EQ(rm, rep);
+            xarray<int, layout_type::column_major> cm = rep;
+            EXPECT_EQ(cm, rep);
+
+            std::vector<std::size_t> view_repeats(v.shape()[axis], 1);
+            view_repeats[0] = 4;
+            auto vrep = xt::repeat(v, view_repeats, axis);
+            xarray<int> vrm = vrep;
+            EXPECT_EQ(vrm, vrep);
+            xarray<int, layout_type::column_major> vcm = vrep;
+            EXPECT_EQ(vcm, vrep);
+        }
+
+        xarray<int> b = {1, 2, 3};
+        xarray<int> rb = xt::repeat(b, 4, 0);
+        xarray<int> expected = {1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3};
+        EXPECT_EQ(rb, expected);
+    }
+
     TEST(xrepeat_stepper, step_with_repeat_1)
     {
         xarray<size_t> array = {
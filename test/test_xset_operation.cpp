@@ -7,11 +7,19 @@
  * The full license is in the file LICENSE, distributed with this software. *
  ****************************************************************************/
 
+#include <algorithm>
+#include <complex>
 #include <cstddef>
+#include <limits>
+#include <vector>
 
 #include "xtensor/containers/xarray.hpp"
+#include "xtensor/containers/xadapt.hpp"
 #include "xtensor/containers/xtensor.hpp"
+#include "xtensor/generators/xbuilder.hpp"
 #include "xtensor/misc/xset_operation.hpp"
+#include "xtensor/misc/xsort.hpp"
+#include "xtensor/views/xview.hpp"
 
 #include "test_common_macros.hpp"
 
@@ -37,6 +45,52 @@ namespace xt
         EXPECT_EQ(xt::in1d(a, {1, 2}), res);
     }
 
+    TEST(xset_operation, isin_large)
+    {
+        // test sets scanned linearly, searched by bisection and hashed
+        xt::xtensor<int, 1> a = xt::arange<int>(-50, 5000);
+        for (std::size_t count : {std::size_t(5), std::size_t(100), std::size_t(3000)})
+        {
+            std::vector<int> test;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                test.push_back(static_cast<int>((i * 37) % 4001) - 20);
+            }
+            auto res = xt::isin(a, test);
+            for (std::size_t i = 0; i < a.size(); ++i)
+            {
+                bool expected = std::find(test.cbegin(), test.cend(), a(i)) != test.cend();
+                EXPECT_EQ(res(i), expected);
+            }
+            xt::xtensor<bool, 1> res_it = xt::in1d(a, test.begin(), test.end());
+            EXPECT_EQ(res_it, res);
+        }
+
+        // elements and test elements are compared in their common type
+        xt::xtensor<int, 1> ints = {1, 2, 3};
+        std::vector<double> halves(40);
+        for (std::size_t i = 0; i < halves.size(); ++i)
+        {
+            halves[i] = 0.5 + static_cast<double>(i);
+        }
+        halves.push_back(3.);
+        xt::xtensor<bool, 1> res_mixed = {false, false, true};
+        EXPECT_EQ(xt::isin(ints, halves), res_mixed);
+
+        // NaN never matches
+        xt::xtensor<double, 1> d = {std::numeric_limits<double>::quiet_NaN(), 0., -0.};
+        std::vector<double> with_nan = {std::numeric_limits<double>::quiet_NaN(), 0.};
+        xt::xtensor<bool, 1> res_nan = {false, true, true};
+        EXPECT_EQ(xt::isin(d, with_nan), res_nan);
+
+        // neither hashable nor ordered
+        xt::xtensor<std::complex<double>, 1> c = {{1., 1.}, {2., 0.}};
+        std::vector<std::complex<double>> ctest(30, std::complex<double>(0., 3.));
+        ctest.push_back({1., 1.});
+        xt::xtensor<bool, 1> res_c = {true, false};
+        EXPECT_EQ(xt::isin(c, ctest), res_c);
+    }
+
     TEST(xset_operation, searchsorted)
     {
         xt::xtensor<size_t, 1> a = {1, 2, 7, 8, 20};
@@ -47,4 +101,46 @@ namespace xt
         EXPECT_EQ(xt::searchsorted(a, v, true), res_right);
         EXPECT_EQ(xt::searchsorted(a, v, false), res_left);
     }
+
+    TEST(xset_operation, searchsorted_large)
+    {
+        // duplicated values, random and sorted queries, several parallel blocks
+        std::vector<double> values(1000);
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            values[i] = static_cast<double>(i / 3);
+        }
+        xt::xtensor<double, 1> a = xt::adapt(values, {values.size()});
+
+        const std::size_t n = 10007;
+        xt::xtensor<double, 1> v = xt::xtensor<double, 1>::from_shape({n});
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            v(i) = static_cast<double>((i * 7919) % 700) / 2. - 10.;
+        }
+        xt::xtensor<double, 1> sorted_v = xt::sort(v);
+
+        for (const auto& q : {v, sorted_v})
+        {
+            auto left = xt::searchsorted(a, q, true);
+            auto right = xt::searchsorted(a, q, false);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                auto lb = std::lower_bound(values.cbegin(), values.cend(), q(i)) - values.cbegin();
+                auto ub = std::upper_bound(values.cbegin(), values.cend(), q(i)) - values.cbegin();
+                EXPECT_EQ(left(i), static_cast<std::size_t>(lb));
+                EXPECT_EQ(right(i), static_cast<std::size_t>(ub));
+            }
+        }
+
+        // non contiguous sorted array and 2-D queries
+        auto strided = xt::view(a, xt::range(0, xt::placeholders::_, 3));
+        xt::xtensor<double, 2> q2 = {{-1., 0., 0.5}, {100., 332., 400.}};
+        xt::xtensor<std::size_t, 2> expected = {{0, 0, 1}, {100, 332, 334}};
+        EXPECT_EQ(xt::searchsorted(strided, q2), expected);
+
+        xt::xtensor<double, 1> empty_a = xt::xtensor<double, 1>::from_shape({0});
+        xt::xtensor<std::size_t, 1> zeros_res = {0, 0, 0};
+        EXPECT_EQ(xt::searchsorted(empty_a, xt::xtensor<double, 1>{1., 2., 3.}), zeros_res);
+    }
 }
@@ -7,7 +7,9 @@
  * The full license is in the file LICENSE, distributed with this software. *
  ****************************************************************************/
 
+#include <complex>
 #include <numeric>
+#include <string>
 
 #include "xtensor/containers/xstorage.hpp"
 #include "xtensor/core/xtensor_config.hpp"
@@ -54,6 +56,27 @@ namespace xt
         }
     }
 
+    TEST(uvector, uninitialized)
+    {
+        static_assert(is_uninitialized_safe<std::complex<double>>::value);
+        static_assert(!is_uninitialized_safe<std::string>::value);
+
+        uvector<std::complex<double>> a(10, uninitialized);
+        EXPECT_EQ(size_t(10), a.size());
+        a.resize(20, uninitialized);
+        EXPECT_EQ(size_t(20), a.size());
+        std::fill(a.begin(), a.end(), std::complex<double>(1., 2.));
+        EXPECT_EQ(std::complex<double>(1., 2.), a[15]);
+
+        // Types that cannot be left unconstructed are value-initialized
+        uvector<std::string> b(5, uninitialized);
+        EXPECT_EQ(size_t(5), b.size());
+        EXPECT_TRUE(b[3].empty());
+        b.resize(8, uninitialized);
+        EXPECT_EQ(size_t(8), b.size());
+        EXPECT_TRUE(b[7].empty());
+    }
+
     TEST(uvector, access)
     {
         vector_type a(10);
@@ -334,6 +357,100 @@ namespace xt
         }
     }
 
+    /******************
+     * compact_vector *
+     ******************/
+
+    using compact_type = compact_vector<std::size_t, 4>;
+
+    TEST(compact_vector, constructor)
+    {
+        EXPECT_EQ(sizeof(compact_type), 4 * sizeof(std::size_t) + 8);
+
+        compact_type a;
+        EXPECT_EQ(size_t(0), a.size());
+        EXPECT_TRUE(a.on_stack());
+
+        compact_type b(10, size_t(2));
+        EXPECT_EQ(size_t(10), b.size());
+        EXPECT_FALSE(b.on_stack());
+        EXPECT_EQ(size_t(2), b[9]);
+
+        compact_type c = {1, 2, 3};
+        EXPECT_EQ(size_t(3), c.size());
+        EXPECT_TRUE(c.on_stack());
+        EXPECT_EQ(size_t(3), c[2]);
+
+        compact_type d(b);
+        EXPECT_EQ(b, d);
+        compact_type e(std::move(d));
+        EXPECT_EQ(b, e);
+        EXPECT_TRUE(d.empty());
+
+        std::vector<size_t> src = {4, 5, 6, 7, 8};
+        compact_type f(src.cbegin(), src.cend());
+        EXPECT_EQ(src, f);
+    }
+
+    TEST(compact_vector, assign)
+    {
+        compact_type a = {1, 2, 3};
+        compact_type b(10, size_t(2));
+        a = b;
+        EXPECT_EQ(b, a);
+        b = {4, 5};
+        EXPECT_EQ(size_t(2), b.size());
+        EXPECT_EQ(size_t(5), b[1]);
+        a = std::move(b);
+        EXPECT_EQ(size_t(2), a.size());
+        EXPECT_EQ(size_t(4), a[0]);
+    }
+
+    TEST(compact_vector, resize)
+    {
+        compact_type a;
+        for (size_t i = 1; i < 11; ++i)
+        {
+            a.resize(i);
+            a.back() = i;
+            EXPECT_EQ(i, a.size());
+        }
+        for (size_t i = 1; i < 11; ++i)
+        {
+            EXPECT_EQ(i, a[i - 1]);
+        }
+        a.resize(3);
+        a.shrink_to_fit();
+        EXPECT_TRUE(a.on_stack());
+        EXPECT_EQ(size_t(3), a[2]);
+    }
+
+    TEST(compact_vector, insert_erase)
+    {
+        compact_type a = {1, 2, 3};
+        a.insert(a.begin() + 1, size_t(8));
+        a.insert(a.end(), {5, 6});
+        a.push_back(7);
+        compact_type expected = {1, 8, 2, 3, 5, 6, 7};
+        EXPECT_EQ(expected, a);
+        a.erase(a.begin(), a.begin() + 4);
+        a.pop_back();
+        expected = {5, 6};
+        EXPECT_EQ(expected, a);
+        XT_EXPECT_ANY_THROW(a.at(2));
+    }
+
+    TEST(compact_vector, swap)
+    {
+        compact_type a = {1, 2};
+        compact_type b(8, size_t(3));
+        compact_type ac = a;
+        compact_type bc = b;
+        swap(a, b);
+        EXPECT_EQ(bc, a);
+        EXPECT_EQ(ac, b);
+    }
+
     TEST(fixed_shape, fixed_shape)
     {
         fixed_shape<3, 4, 5> af;
@@ -7,6 +7,7 @@
  * The full license is in the file LICENSE, distributed with this software. *
  ****************************************************************************/
 
+#include <complex>
 #include <type_traits>
 
 #include "xtensor/containers/xarray.hpp"
@@ -63,6 +64,19 @@ namespace xt
             EXPECT_TRUE(std::equal(expected_shape.begin(), expected_shape.end(), ca.shape().begin()));
             EXPECT_TRUE(std::equal(shp.begin(), shp.end(), cb.shape().begin()));
         }
+
+        SUBCASE("uninitialized")
+        {
+            column_major_result<storage_type> cm;
+            xtensor_dynamic ca(cm.m_shape, uninitialized, layout_type::column_major);
+            compare_shape(ca, cm);
+
+            auto cc = xtensor<std::complex<double>, 3>::from_shape({3, 2, 1}, uninitialized);
+            std::vector<std::size_t> expected_shape = {3, 2, 1};
+            EXPECT_TRUE(std::equal(expected_shape.begin(), expected_shape.end(), cc.shape().begin()));
+            cc.fill(std::complex<double>(1., 2.));
+            EXPECT_EQ(std::complex<double>(1., 2.), cc(2, 1, 0));
+        }
     }
 
     TEST(xtensor, strided_constructor)